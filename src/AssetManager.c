@@ -0,0 +1,755 @@
+/* N64 GAME ENGINE */
+// Asset manager file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmodel.h>
+#include "N64GameEngine.h"
+#include "AssetManager.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "Profiler.h"
+#include "TextUtils.h"
+
+
+/* VARIABLES */
+struct AssetEntry AssetTable[ASSET_TABLE_SIZE];
+struct AssetLoadRequest AssetLoads[ASSET_LOAD_QUEUE_SIZE];
+struct DeferredAssetFree DeferredAssetFrees[ASSET_DEFERRED_FREE_QUEUE_SIZE];
+const char* AssetTypeNames[] = {"MODEL", "FONT", "SPRITE"};
+enum MemoryTags AssetTypeTags[] = {MEMORY_TAG_MODEL, MEMORY_TAG_FONT, MEMORY_TAG_SPRITE};
+float AssetLoadBudgetMS = ASSET_LOAD_DEFAULT_BUDGET_MS;
+int LoadedAssetCount = 0;
+int AssetLoadsAvoided = 0;
+int PendingAssetLoads = 0;
+int NextAssetLoadHandle = 1;
+int DeferredAssetFreeCount = 0;
+uint32_t DeferredAssetFreeFrame = 0;
+
+// The file the memory filesystem serves (see OpenMemoryFile). It's only set while a model is being built from an
+// async load's buffer
+const uint8_t* MemoryFileData = NULL;
+int MemoryFileSize = 0;
+int MemoryFilePosition = 0;
+bool MemoryFilesystemAttached = false;
+
+
+/* FUNCTIONS */
+// ----- Memory filesystem functions -----
+// Tiny3D can only load models from a path, so a model that was read by an async load is handed to it through a tiny
+// filesystem (ASSET_MEMORY_FS_PREFIX) that serves the load's buffer. Only one file can be open at a time
+void* OpenMemoryFile(char* Name, int Flags)
+{
+    if (MemoryFileData == NULL)
+    {
+        return NULL;
+    }
+
+    MemoryFilePosition = 0;
+    return (void*)MemoryFileData;
+}
+
+int StatMemoryFile(void* File, struct stat* Stats)
+{
+    memset(Stats, 0, sizeof(struct stat));
+    Stats->st_mode = S_IFREG;
+    Stats->st_size = MemoryFileSize;
+    return 0;
+}
+
+int SeekMemoryFile(void* File, int Offset, int Whence)
+{
+    int NewPosition = Whence == SEEK_SET ? Offset : Whence == SEEK_CUR ? MemoryFilePosition + Offset : MemoryFileSize + Offset;
+
+    MemoryFilePosition = MIN(MAX(NewPosition, 0), MemoryFileSize);
+    return MemoryFilePosition;
+}
+
+int ReadMemoryFile(void* File, uint8_t* Buffer, int Length)
+{
+    int BytesRead = MIN(Length, MemoryFileSize - MemoryFilePosition);
+
+    memcpy(Buffer, MemoryFileData + MemoryFilePosition, BytesRead);
+    MemoryFilePosition += BytesRead;
+    return BytesRead;
+}
+
+int CloseMemoryFile(void* File)
+{
+    return 0;
+}
+
+// Load a model from a buffer holding its (decompressed) file. Tiny3D copies the data, so the buffer can be freed after
+T3DModel* LoadModelFromBuffer(const char* Path, const uint8_t* Buffer, int Size)
+{
+    static filesystem_t MemoryFilesystem = {
+        .open = OpenMemoryFile,
+        .fstat = StatMemoryFile,
+        .lseek = SeekMemoryFile,
+        .read = ReadMemoryFile,
+        .close = CloseMemoryFile,
+    };
+    char MemoryPath[ASSET_PATH_MAX_BYTES + sizeof(ASSET_MEMORY_FS_PREFIX)];
+
+    if (MemoryFilesystemAttached == false)
+    {
+        assertf(attach_filesystem(ASSET_MEMORY_FS_PREFIX, &MemoryFilesystem) >= 0, "Failed to attach the asset memory filesystem!");
+        MemoryFilesystemAttached = true;
+    }
+
+    // The path is only there to make errors readable, the filesystem always serves the current buffer
+    snprintf(MemoryPath, sizeof(MemoryPath), "%s%s", ASSET_MEMORY_FS_PREFIX, strchr(Path, '/') != NULL ? strchr(Path, '/') + 1 : Path);
+    MemoryFileData = Buffer;
+    MemoryFileSize = Size;
+
+    T3DModel* Model = t3d_model_load(MemoryPath);
+
+    MemoryFileData = NULL;
+    MemoryFileSize = 0;
+    return Model;
+}
+
+// ----- Helper functions -----
+// Get the table slot a path hash would ideally be stored in
+uint32_t GetAssetHomeSlot(uint32_t Hash)
+{
+    return Hash & (ASSET_TABLE_SIZE - 1);
+}
+
+// Load an asset from the ROM and track its memory under the tag that matches its type. The asset's size is the growth
+// of the heap during the load
+void* LoadAssetData(const char* Path, enum AssetTypes Type, uint32_t* Bytes)
+{
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+    void* Data;
+
+    switch (Type)
+    {
+        case ASSET_MODEL:
+            Data = t3d_model_load(Path);
+            break;
+
+        case ASSET_FONT:
+            Data = rdpq_font_load(Path);
+            break;
+
+        default:
+            Data = sprite_load(Path);
+            break;
+    }
+
+    uint32_t HeapUsed = GetHeapUsedBytes();
+
+    *Bytes = HeapUsed > HeapUsedBefore ? HeapUsed - HeapUsedBefore : 0;
+    TrackAllocation(Data, *Bytes, AssetTypeTags[Type]);
+    return Data;
+}
+
+// Free an asset's data right away (and a model's shared render block, or the buffer an async load built it from).
+// Nothing queued on the RSP can still be using it
+void FreeAssetDataNow(struct DeferredAssetFree* Free)
+{
+    switch (Free->Type)
+    {
+        case ASSET_MODEL:
+            if (Free->RenderBlock != NULL)
+            {
+                UntrackAllocation(Free->RenderBlock);
+                rspq_block_free(Free->RenderBlock);
+            }
+
+            FreeModel(Free->Data);
+            break;
+
+        case ASSET_FONT:
+            UntrackAllocation(Free->Data);
+            rdpq_font_free(Free->Data);
+            break;
+
+        default:
+            UntrackAllocation(Free->Data);
+            sprite_free(Free->Data);
+            break;
+    }
+
+    // Fonts and sprites built from a buffer don't free it themselves
+    free(Free->Buffer);
+}
+
+// Free a released asset once the frames that could still be drawing it are done (see UpdateDeferredAssetFrees), so
+// releasing an asset never waits on the RSP. If the queue is full, the RSP is waited on and the asset is freed now
+void FreeAssetData(struct AssetEntry* Entry)
+{
+    struct DeferredAssetFree Free = {Entry->Data, Entry->Buffer, Entry->RenderBlock, DeferredAssetFreeFrame, Entry->Type};
+
+    if (DeferredAssetFreeCount == ASSET_DEFERRED_FREE_QUEUE_SIZE)
+    {
+        DebugPrint("[WARNING] >> The deferred asset free queue is full, waiting on the RSP to free \"%s\".\n", ALL, Entry->Path);
+        rspq_wait();
+        FreeAssetDataNow(&Free);
+        return;
+    }
+
+    DeferredAssetFrees[DeferredAssetFreeCount++] = Free;
+}
+
+// Remove an entry from the asset table. Later entries in the same probe chain are shifted back into the hole, so
+// lookups never need to skip over removed entries
+void RemoveAssetEntry(struct AssetEntry* Entry)
+{
+    uint32_t Hole = Entry - AssetTable;
+
+    LoadedAssetCount--;
+
+    for (uint32_t Next = (Hole + 1) & (ASSET_TABLE_SIZE - 1); AssetTable[Next].Data != NULL; Next = (Next + 1) & (ASSET_TABLE_SIZE - 1))
+    {
+        uint32_t Home = GetAssetHomeSlot(AssetTable[Next].Hash);
+
+        // The entry can only be moved if the hole is between its home slot and where it is now
+        if (((Next - Home) & (ASSET_TABLE_SIZE - 1)) >= ((Next - Hole) & (ASSET_TABLE_SIZE - 1)))
+        {
+            AssetTable[Hole] = AssetTable[Next];
+            Hole = Next;
+        }
+    }
+
+    memset(&AssetTable[Hole], 0, sizeof(struct AssetEntry));
+}
+
+// Add a loaded asset to the table with one reference
+struct AssetEntry* AddAssetEntry(const char* Path, enum AssetTypes Type, void* Data, void* Buffer, uint32_t Bytes)
+{
+    // One slot is always left empty so probing always ends
+    assertf(LoadedAssetCount < ASSET_TABLE_SIZE - 1, "Too many assets are loaded (%d max)!", ASSET_TABLE_SIZE - 1);
+
+    uint32_t Hash = HashString(Path);
+    uint32_t Slot = GetAssetHomeSlot(Hash);
+
+    while (AssetTable[Slot].Data != NULL)
+    {
+        Slot = (Slot + 1) & (ASSET_TABLE_SIZE - 1);
+    }
+
+    struct AssetEntry* Entry = &AssetTable[Slot];
+
+    strcpy(Entry->Path, Path);
+    Entry->Data = Data;
+    Entry->Buffer = Buffer;
+    Entry->RenderBlock = NULL;
+    Entry->RenderBlockBytes = 0;
+    Entry->Hash = Hash;
+    Entry->Bytes = Bytes;
+    Entry->RefCount = 1;
+    Entry->Type = Type;
+    LoadedAssetCount++;
+
+    DebugPrint("[INFO] >> Loaded %s \"%s\" (%d bytes).\n", ALL, AssetTypeNames[Type], Entry->Path, (int)Bytes);
+    return Entry;
+}
+
+// Get the asset loaded from a path, or load it if it hasn't been. Either way, a reference is added to it
+void* AcquireAsset(char* Path, enum AssetTypes Type)
+{
+    struct AssetEntry* Entry = FindAsset(Path);
+
+    if (Entry != NULL)
+    {
+        assertf(Entry->Type == Type, "\"%s\" is already loaded as a %s!", Path, AssetTypeNames[Entry->Type]);
+
+        Entry->RefCount++;
+        AssetLoadsAvoided++;
+        DebugPrint("[INFO] >> Reusing %s \"%s\" (%d references).\n", ALL, AssetTypeNames[Type], Path, Entry->RefCount);
+        return Entry->Data;
+    }
+
+    assertf(strlen(Path) < ASSET_PATH_MAX_BYTES, "The asset path \"%s\" is too long (%d bytes max)!", Path, ASSET_PATH_MAX_BYTES - 1);
+
+    uint32_t Bytes = 0;
+    void* Data = LoadAssetData(Path, Type, &Bytes);
+
+    assertf(Data != NULL, "Failed to load %s \"%s\"!", AssetTypeNames[Type], Path);
+    return AddAssetEntry(Path, Type, Data, NULL, Bytes)->Data;
+}
+
+// Find the async load a handle belongs to, or NULL if the handle is invalid
+struct AssetLoadRequest* FindAssetLoad(int Handle)
+{
+    for (int Slot = 0; Slot < ASSET_LOAD_QUEUE_SIZE; Slot++)
+    {
+        if (AssetLoads[Slot].State != ASSET_LOAD_INVALID && AssetLoads[Slot].Handle == Handle)
+        {
+            return &AssetLoads[Slot];
+        }
+    }
+
+    return NULL;
+}
+
+// Find the oldest async load that isn't finished yet. Loads are worked on one at a time, in the order they were requested
+struct AssetLoadRequest* GetNextAssetLoad()
+{
+    struct AssetLoadRequest* Oldest = NULL;
+
+    for (int Slot = 0; Slot < ASSET_LOAD_QUEUE_SIZE; Slot++)
+    {
+        struct AssetLoadRequest* Request = &AssetLoads[Slot];
+
+        if ((Request->State == ASSET_LOAD_QUEUED || Request->State == ASSET_LOAD_READING) && (Oldest == NULL || Request->Handle < Oldest->Handle))
+        {
+            Oldest = Request;
+        }
+    }
+
+    return Oldest;
+}
+
+// Mark an async load as finished. If it has a callback, the asset is handed to it and the load's slot is freed right away
+void FinishAssetLoad(struct AssetLoadRequest* Request)
+{
+    Request->State = ASSET_LOAD_READY;
+    PendingAssetLoads--;
+
+    if (Request->Callback != NULL)
+    {
+        Request->State = ASSET_LOAD_INVALID;
+        Request->Callback(Request->Handle, Request->Data, Request->UserData);
+    }
+}
+
+// Start an async load. Assets that are already loaded are finished right away, and true is returned for them.
+// Otherwise the asset's file is opened, and a buffer for its (decompressed) data is allocated
+bool StartAssetLoad(struct AssetLoadRequest* Request)
+{
+    if (FindAsset(Request->Path) != NULL)
+    {
+        Request->Data = AcquireAsset(Request->Path, Request->Type);
+        FinishAssetLoad(Request);
+        return true;
+    }
+
+    Request->File = asset_fopen(Request->Path, &Request->Size);
+    Request->Buffer = memalign(16, Request->Size);
+    Request->BytesRead = 0;
+    Request->State = ASSET_LOAD_READING;
+
+    assertf(Request->Buffer != NULL, "Failed to allocate %d bytes to load \"%s\"!", Request->Size, Request->Path);
+    return false;
+}
+
+// Read (and decompress) the next chunk of an async load's file. Once the whole file has been read, the asset is built
+// from the buffer and added to the asset table. Fonts and sprites keep using the buffer, while a model is copied out of
+// it by Tiny3D (which only costs a copy in RAM, the ROM reads and decompression are already done by then)
+void ContinueAssetLoad(struct AssetLoadRequest* Request)
+{
+    int ChunkBytes = MIN(ASSET_LOAD_CHUNK_BYTES, Request->Size - Request->BytesRead);
+    int BytesRead = fread(Request->Buffer + Request->BytesRead, 1, ChunkBytes, Request->File);
+
+    assertf(BytesRead == ChunkBytes, "Failed to read \"%s\" (%d / %d bytes)!", Request->Path, Request->BytesRead + BytesRead, Request->Size);
+    Request->BytesRead += BytesRead;
+
+    if (Request->BytesRead < Request->Size)
+    {
+        return;
+    }
+
+    fclose(Request->File);
+    Request->File = NULL;
+
+    // The asset could have been loaded with AcquireAsset while its file was being read, in which case the loaded copy
+    // is shared instead of adding a second entry for the same path
+    if (FindAsset(Request->Path) != NULL)
+    {
+        free(Request->Buffer);
+        Request->Buffer = NULL;
+        Request->Data = AcquireAsset(Request->Path, Request->Type);
+        FinishAssetLoad(Request);
+        return;
+    }
+
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+
+    switch (Request->Type)
+    {
+        case ASSET_MODEL:
+            Request->Data = LoadModelFromBuffer(Request->Path, Request->Buffer, Request->Size);
+            break;
+
+        case ASSET_FONT:
+            Request->Data = rdpq_font_load_buf(Request->Buffer, Request->Size);
+            break;
+
+        default:
+            Request->Data = sprite_load_buf(Request->Buffer, Request->Size);
+            break;
+    }
+
+    assertf(Request->Data != NULL, "Failed to load %s \"%s\"!", AssetTypeNames[Request->Type], Request->Path);
+
+    // A font's or sprite's buffer is counted as part of the asset, since it's freed along with it
+    uint32_t HeapUsed = GetHeapUsedBytes();
+    uint32_t Bytes = HeapUsed > HeapUsedBefore ? HeapUsed - HeapUsedBefore : 0;
+
+    if (Request->Type == ASSET_MODEL)
+    {
+        free(Request->Buffer);
+        Request->Buffer = NULL;
+    }
+    else
+    {
+        Bytes += Request->Size;
+    }
+
+    TrackAllocation(Request->Data, Bytes, AssetTypeTags[Request->Type]);
+    AddAssetEntry(Request->Path, Request->Type, Request->Data, Request->Buffer, Bytes);
+    Request->Buffer = NULL;
+    FinishAssetLoad(Request);
+}
+
+// Work on async loads until they're all finished, or (if Budgeted is set) until BudgetTicks have passed
+void ProcessAssetLoads(uint32_t BudgetTicks, bool Budgeted)
+{
+    uint32_t StartTicks = TICKS_READ();
+    bool DidWork = false;
+
+    while (PendingAssetLoads > 0)
+    {
+        // At least one step is taken per slice, so loads always make progress even with a tiny budget
+        if (Budgeted == true && DidWork == true && (uint32_t)TICKS_DISTANCE(StartTicks, TICKS_READ()) >= BudgetTicks)
+        {
+            break;
+        }
+
+        struct AssetLoadRequest* Request = GetNextAssetLoad();
+
+        if (Request->State == ASSET_LOAD_QUEUED)
+        {
+            DidWork = true;
+
+            if (StartAssetLoad(Request) == true)
+            {
+                continue;
+            }
+        }
+
+        DidWork = true;
+        ContinueAssetLoad(Request);
+    }
+}
+
+// ----- Acquire functions -----
+// Get a model by its ROM path, loading it if it isn't loaded yet. Release it with ReleaseAsset when it's not needed anymore
+T3DModel* AcquireModel(char* ModelPath)
+{
+    return AcquireAsset(ModelPath, ASSET_MODEL);
+}
+
+// Get a font by its ROM path, loading it if it isn't loaded yet. A font must not be released while it's registered
+rdpq_font_t* AcquireFont(char* FontPath)
+{
+    return AcquireAsset(FontPath, ASSET_FONT);
+}
+
+// Get a sprite by its ROM path, loading it if it isn't loaded yet
+sprite_t* AcquireSprite(char* SpritePath)
+{
+    return AcquireAsset(SpritePath, ASSET_SPRITE);
+}
+
+// Release a reference to an asset. The asset is freed when its last reference is released (or rather a few frames
+// later, see FreeAssetData), so nothing may queue new draws of it (including transforms using a model's shared render
+// block) after that. Returns the number of bytes that will be freed, which is 0 if the asset still has other references
+uint32_t ReleaseAsset(void* Asset)
+{
+    struct AssetEntry* Entry = FindAssetByData(Asset);
+
+    assertf(Entry != NULL, "Tried to release an asset that wasn't acquired through the asset manager!");
+
+    if (--Entry->RefCount > 0)
+    {
+        return 0;
+    }
+
+    uint32_t Bytes = Entry->Bytes + Entry->RenderBlockBytes;
+
+    DebugPrint("[INFO] >> Freeing %s \"%s\" (%d bytes).\n", ALL, AssetTypeNames[Entry->Type], Entry->Path, (int)Bytes);
+    FreeAssetData(Entry);
+    RemoveAssetEntry(Entry);
+    return Bytes;
+}
+
+// ----- Async loading functions -----
+// Request an asset to be loaded over the next few frames (see UpdateAssetLoads), and get a handle to the load. The
+// handle can be polled with GetAssetLoadState and GetLoadedAsset, or Callback (which can be NULL) is called with the
+// asset once it's loaded. Either way, the load acquires a reference to the asset, which is released with ReleaseAsset
+int RequestAsset(char* Path, enum AssetTypes Type, AssetLoadCallback Callback, void* UserData)
+{
+    assertf(strlen(Path) < ASSET_PATH_MAX_BYTES, "The asset path \"%s\" is too long (%d bytes max)!", Path, ASSET_PATH_MAX_BYTES - 1);
+
+    for (int Slot = 0; Slot < ASSET_LOAD_QUEUE_SIZE; Slot++)
+    {
+        struct AssetLoadRequest* Request = &AssetLoads[Slot];
+
+        if (Request->State == ASSET_LOAD_INVALID)
+        {
+            strcpy(Request->Path, Path);
+            Request->File = NULL;
+            Request->Buffer = NULL;
+            Request->Data = NULL;
+            Request->Callback = Callback;
+            Request->UserData = UserData;
+            Request->Handle = NextAssetLoadHandle++;
+            Request->Size = 0;
+            Request->BytesRead = 0;
+            Request->Type = Type;
+            Request->State = ASSET_LOAD_QUEUED;
+            PendingAssetLoads++;
+
+            DebugPrint("[INFO] >> Requested %s \"%s\" (handle %d).\n", ALL, AssetTypeNames[Type], Path, Request->Handle);
+            return Request->Handle;
+        }
+    }
+
+    assertf(false, "Too many async asset loads were requested (%d max)!", ASSET_LOAD_QUEUE_SIZE);
+    return 0;
+}
+
+// Get the state of an async load. The handle of a load that's been handed over (or canceled) is invalid
+enum AssetLoadStates GetAssetLoadState(int Handle)
+{
+    struct AssetLoadRequest* Request = FindAssetLoad(Handle);
+
+    return Request != NULL ? Request->State : ASSET_LOAD_INVALID;
+}
+
+// Get the asset of a finished async load, or NULL if it isn't finished yet. Once the asset has been returned, the
+// handle is invalid and the caller owns the load's reference
+void* GetLoadedAsset(int Handle)
+{
+    struct AssetLoadRequest* Request = FindAssetLoad(Handle);
+
+    if (Request == NULL || Request->State != ASSET_LOAD_READY)
+    {
+        return NULL;
+    }
+
+    Request->State = ASSET_LOAD_INVALID;
+    return Request->Data;
+}
+
+// Cancel an async load. If it's already finished, its reference is released
+void CancelAssetLoad(int Handle)
+{
+    struct AssetLoadRequest* Request = FindAssetLoad(Handle);
+
+    if (Request == NULL)
+    {
+        return;
+    }
+
+    if (Request->State == ASSET_LOAD_READY)
+    {
+        ReleaseAsset(Request->Data);
+    }
+    else
+    {
+        if (Request->File != NULL)
+        {
+            fclose(Request->File);
+        }
+
+        free(Request->Buffer);
+        PendingAssetLoads--;
+    }
+
+    Request->State = ASSET_LOAD_INVALID;
+}
+
+// Work on the requested async loads for up to AssetLoadBudgetMS. This is called once per frame by EndFrame, after
+// the frame has been handed to the RDP
+void UpdateAssetLoads()
+{
+    if (PendingAssetLoads == 0)
+    {
+        return;
+    }
+
+    PROFILE_BEGIN(PROFILE_ZONE_ASSET_LOADS);
+    ProcessAssetLoads(TICKS_FROM_US(AssetLoadBudgetMS * 1000.0f), true);
+    PROFILE_END(PROFILE_ZONE_ASSET_LOADS);
+}
+
+// Finish every requested async load right away, ignoring the budget (EX: behind a loading screen)
+void FinishAssetLoads()
+{
+    ProcessAssetLoads(0, false);
+}
+
+// ----- Deferred free functions -----
+// Free the released assets whose frames have all been displayed. This is called once per frame by StartFrame, after
+// display_get has returned, which only happens once the frame that last used that buffer is done. An asset released
+// during a frame can't be drawn by later ones, so it's safe to free DisplayBufferCount frames after it was released
+void UpdateDeferredAssetFrees()
+{
+    int Kept = 0;
+
+    DeferredAssetFreeFrame++;
+
+    for (int Index = 0; Index < DeferredAssetFreeCount; Index++)
+    {
+        if (DeferredAssetFreeFrame - DeferredAssetFrees[Index].Frame >= DisplayBufferCount)
+        {
+            FreeAssetDataNow(&DeferredAssetFrees[Index]);
+        }
+        else
+        {
+            DeferredAssetFrees[Kept++] = DeferredAssetFrees[Index];
+        }
+    }
+
+    DeferredAssetFreeCount = Kept;
+}
+
+// Wait on the RSP and free every released asset right away (EX: when the heap is needed back immediately)
+void FlushDeferredAssetFrees()
+{
+    if (DeferredAssetFreeCount == 0)
+    {
+        return;
+    }
+
+    rspq_wait();
+
+    for (int Index = 0; Index < DeferredAssetFreeCount; Index++)
+    {
+        FreeAssetDataNow(&DeferredAssetFrees[Index]);
+    }
+
+    DeferredAssetFreeCount = 0;
+}
+
+// ----- Lookup functions -----
+// Find the entry of a loaded asset by its ROM path, or NULL if it isn't loaded
+struct AssetEntry* FindAsset(const char* Path)
+{
+    uint32_t Hash = HashString(Path);
+
+    for (uint32_t Slot = GetAssetHomeSlot(Hash); AssetTable[Slot].Data != NULL; Slot = (Slot + 1) & (ASSET_TABLE_SIZE - 1))
+    {
+        if (AssetTable[Slot].Hash == Hash && strcmp(AssetTable[Slot].Path, Path) == 0)
+        {
+            return &AssetTable[Slot];
+        }
+    }
+
+    return NULL;
+}
+
+// Find the entry of a loaded asset by its data, or NULL if it wasn't acquired through the asset manager. The table is
+// small, so every slot is checked
+struct AssetEntry* FindAssetByData(const void* Asset)
+{
+    if (Asset == NULL)
+    {
+        return NULL;
+    }
+
+    for (int Slot = 0; Slot < ASSET_TABLE_SIZE; Slot++)
+    {
+        if (AssetTable[Slot].Data == Asset)
+        {
+            return &AssetTable[Slot];
+        }
+    }
+
+    return NULL;
+}
+
+// Check if an asset was acquired through the asset manager
+bool IsManagedAsset(const void* Asset)
+{
+    return FindAssetByData(Asset) != NULL;
+}
+
+// Get the render block shared by every transform that draws a model, recording it the first time it's needed.
+// Returns NULL if the model wasn't acquired through the asset manager, since nothing would own the block
+rspq_block_t* GetSharedRenderBlock(T3DModel* Model)
+{
+    struct AssetEntry* Entry = FindAssetByData(Model);
+
+    if (Entry == NULL || Entry->Type != ASSET_MODEL)
+    {
+        return NULL;
+    }
+
+    if (Entry->RenderBlock == NULL)
+    {
+        uint32_t HeapUsedBefore = GetHeapUsedBytes();
+
+        rspq_block_begin();
+        t3d_model_draw(Model);
+        Entry->RenderBlock = rspq_block_end();
+        TrackAllocationSince(Entry->RenderBlock, HeapUsedBefore, MEMORY_TAG_RENDER_BLOCK);
+
+        uint32_t HeapUsed = GetHeapUsedBytes();
+        Entry->RenderBlockBytes = HeapUsed > HeapUsedBefore ? HeapUsed - HeapUsedBefore : 0;
+    }
+
+    return Entry->RenderBlock;
+}
+
+// Get the size of an asset's (decompressed) file without loading it, which is close to the memory the asset takes up
+// once it's loaded. Only the file's header is read
+uint32_t GetAssetFileSize(const char* Path)
+{
+    int Size = 0;
+    FILE* File = asset_fopen(Path, &Size);
+
+    assertf(File != NULL, "Failed to open \"%s\"!", Path);
+    fclose(File);
+    return Size;
+}
+
+// ----- Reporting functions -----
+// Get the number of bytes that would be in use right now if every reference had loaded its own copy of its asset
+// (and every model reference recorded its own render block), minus the bytes actually in use
+uint32_t GetAssetBytesSaved()
+{
+    uint32_t BytesSaved = 0;
+
+    for (int Slot = 0; Slot < ASSET_TABLE_SIZE; Slot++)
+    {
+        if (AssetTable[Slot].Data != NULL)
+        {
+            BytesSaved += (AssetTable[Slot].Bytes + AssetTable[Slot].RenderBlockBytes) * (AssetTable[Slot].RefCount - 1);
+        }
+    }
+
+    return BytesSaved;
+}
+
+// Print every loaded asset with its reference count and size, and how much memory sharing them saves
+void PrintAssetReport()
+{
+    DebugPrint("[INFO] >> Asset report (%d loaded, %d loads avoided, %d bytes saved):\n", MINIMAL, LoadedAssetCount, AssetLoadsAvoided, (int)GetAssetBytesSaved());
+
+    for (int Slot = 0; Slot < ASSET_TABLE_SIZE; Slot++)
+    {
+        struct AssetEntry* Entry = &AssetTable[Slot];
+
+        if (Entry->Data != NULL)
+        {
+            DebugPrint("    %s \"%s\": %d references, %d bytes (%d render block)\n", MINIMAL, AssetTypeNames[Entry->Type], Entry->Path, Entry->RefCount, (int)Entry->Bytes, (int)Entry->RenderBlockBytes);
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/* N64 GAME ENGINE */
+// Asset manager header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+//
+// Models, fonts and sprites acquired through the asset manager are only loaded once per ROM path. Acquiring a path
+// that's already loaded returns the same asset and adds a reference to it, and ReleaseAsset frees the asset once its
+// last reference is released. Models also share one render block, which every transform drawing the model runs.
+//
+// Assets can also be requested with RequestAsset, which loads them in the background of later frames instead of
+// stopping the game. Their files are read (and decompressed) a chunk at a time, for up to AssetLoadBudgetMS per frame,
+// and the asset is built from the read buffer once it's complete. Tiny3D can only load models from a path, so a
+// model's buffer is handed to it through a small memory filesystem (ASSET_MEMORY_FS_PREFIX). Textures the model
+// references by path are still loaded by Tiny3D itself
+
+
+// Define ASSETMANAGER_H if it hasn't been already
+#ifndef ASSETMANAGER_H
+#define ASSETMANAGER_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define ASSET_TABLE_SIZE 64 // The number of slots in the asset table, has to be a power of 2. One slot is always left empty
+#define ASSET_PATH_MAX_BYTES 64 // The longest ROM path an asset can have, including the null terminator
+#define ASSET_LOAD_QUEUE_SIZE 32 // The number of async loads that can be requested at once
+#define ASSET_LOAD_CHUNK_BYTES (8 * 1024) // The number of bytes an async load reads (and decompresses) at a time
+#define ASSET_LOAD_DEFAULT_BUDGET_MS 2.0f // The default time async loads can take per frame
+#define ASSET_MEMORY_FS_PREFIX "amem:/" // The filesystem async model loads are handed to Tiny3D through
+#define ASSET_DEFERRED_FREE_QUEUE_SIZE 32 // The number of released assets that can be waiting to be freed at once
+
+
+/* VARIABLES */
+enum AssetTypes
+{
+    ASSET_MODEL,
+    ASSET_FONT,
+    ASSET_SPRITE
+};
+
+// The states of an async load. A load's handle is invalid once its asset has been handed over (see GetLoadedAsset)
+enum AssetLoadStates
+{
+    ASSET_LOAD_INVALID,
+    ASSET_LOAD_QUEUED,
+    ASSET_LOAD_READING,
+    ASSET_LOAD_READY
+};
+
+// Called when an async load finishes. The reference the load acquired is handed to the callback
+typedef void (*AssetLoadCallback)(int Handle, void* Asset, void* UserData);
+
+// A loaded asset. Bytes is the heap growth its load caused, and RenderBlock is the model's shared render block
+// (NULL until a transform draws the model for the first time, and always NULL for other asset types). Buffer is the
+// file data an async load built the asset from, which has to outlive the asset
+struct AssetEntry
+{
+    char Path[ASSET_PATH_MAX_BYTES];
+    void* Data;
+    void* Buffer;
+    rspq_block_t* RenderBlock;
+    uint32_t Hash;
+    uint32_t Bytes;
+    uint32_t RenderBlockBytes;
+    int RefCount;
+    enum AssetTypes Type;
+};
+
+// An async load. BytesRead counts up to Size while the file is being read
+struct AssetLoadRequest
+{
+    char Path[ASSET_PATH_MAX_BYTES];
+    FILE* File;
+    uint8_t* Buffer;
+    void* Data;
+    AssetLoadCallback Callback;
+    void* UserData;
+    int Handle;
+    int Size;
+    int BytesRead;
+    enum AssetTypes Type;
+    enum AssetLoadStates State;
+};
+
+// A released asset waiting to be freed. Frame is the value of DeferredAssetFreeFrame when it was released
+struct DeferredAssetFree
+{
+    void* Data;
+    void* Buffer;
+    rspq_block_t* RenderBlock;
+    uint32_t Frame;
+    enum AssetTypes Type;
+};
+
+extern float AssetLoadBudgetMS;
+extern int LoadedAssetCount;
+extern int AssetLoadsAvoided;
+extern int PendingAssetLoads;
+extern int DeferredAssetFreeCount;
+
+
+/* FUNCTIONS */
+// ----- Acquire functions -----
+T3DModel* AcquireModel(char* ModelPath);
+rdpq_font_t* AcquireFont(char* FontPath);
+sprite_t* AcquireSprite(char* SpritePath);
+uint32_t ReleaseAsset(void* Asset);
+
+// ----- Async loading functions -----
+int RequestAsset(char* Path, enum AssetTypes Type, AssetLoadCallback Callback, void* UserData);
+enum AssetLoadStates GetAssetLoadState(int Handle);
+void* GetLoadedAsset(int Handle);
+void CancelAssetLoad(int Handle);
+void UpdateAssetLoads();
+void FinishAssetLoads();
+
+// ----- Deferred free functions -----
+void UpdateDeferredAssetFrees();
+void FlushDeferredAssetFrees();
+
+// ----- Lookup functions -----
+struct AssetEntry* FindAsset(const char* Path);
+struct AssetEntry* FindAssetByData(const void* Asset);
+bool IsManagedAsset(const void* Asset);
+rspq_block_t* GetSharedRenderBlock(T3DModel* Model);
+uint32_t GetAssetFileSize(const char* Path);
+
+// ----- Reporting functions -----
+uint32_t GetAssetBytesSaved();
+void PrintAssetReport();
+#endif
@@ -0,0 +1,281 @@
+/* N64 GAME ENGINE */
+// Engine benchmark program
+// Written by agent
+// October of 2026
+
+
+/* LIBRARIES */
+#include <stdlib.h>
+#include <math.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
+#include "../N64GameEngine.h"
+#include "../MathUtils.h"
+#include "../MemoryUtils.h"
+#include "../TextUtils.h"
+#include "../Globals.h"
+
+
+/* DEFINITIONS */
+#define BENCHMARK_MAX_INSTANCES 512
+#define BENCHMARK_WARMUP_FRAMES 30
+#define BENCHMARK_FRAMES 180
+#define CPU_CYCLES_PER_TIMER_TICK 2 // The timer counts at half of the CPU's clock rate
+
+
+/* VARIABLES */
+// A single benchmark scene. Run is called once per frame (in 3D mode) and should draw InstanceCount objects
+struct BenchmarkScene
+{
+    char* Name;
+    int InstanceCount;
+    void (*Run)(int InstanceCount);
+};
+
+// The averaged results of a benchmark scene
+struct BenchmarkResult
+{
+    float SubmitMicroseconds;
+    float FrameMilliseconds;
+    float CyclesPerTransform;
+};
+
+void RunPerObjectScene(int InstanceCount);
+void RunBatchedScene(int InstanceCount);
+void RunFloatSRTScene(int InstanceCount);
+void RunDirectSRTScene(int InstanceCount);
+
+struct BenchmarkScene Scenes[] = {
+    {"Per-object", 16, RunPerObjectScene},
+    {"Batched", 16, RunBatchedScene},
+    {"Per-object", 128, RunPerObjectScene},
+    {"Batched", 128, RunBatchedScene},
+    {"Per-object", 512, RunPerObjectScene},
+    {"Batched", 512, RunBatchedScene},
+    {"Float SRT", 512, RunFloatSRTScene},
+    {"Direct SRT", 512, RunDirectSRTScene},
+};
+
+const int SceneCount = sizeof(Scenes) / sizeof(Scenes[0]);
+struct BenchmarkResult Results[sizeof(Scenes) / sizeof(Scenes[0])];
+struct CameraProperties CamProps;
+struct ControllerState Input;
+struct ModelTransform InstanceTransforms[BENCHMARK_MAX_INSTANCES];
+struct ModelObject FloorObject;
+struct InstanceBatch BushBatch;
+T3DViewport Viewport;
+T3DModel* BushModel;
+T3DVec3 SunDirection = {{-1.0f, 1.0f, 1.0f}};
+uint8_t GlobalLightColor[4] = {0x50, 0x50, 0x64, 0xFF};
+uint8_t SunColor[4] = {0xFB, 0xFF, 0xCD, 0xFF};
+long long SubmitTicks = 0;
+long long TransformTicks = 0;
+long long TransformCount = 0;
+float FrameTimeTotal = 0.0f;
+int CurrentScene = 0;
+int SceneFrame = 0;
+
+
+/* FUNCTIONS */
+// Draw every instance with its own push / set / run / pop round trip
+void RunPerObjectScene(int InstanceCount)
+{
+    for (int InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+    {
+        RenderModelWithTransform(BushModel, &InstanceTransforms[InstanceIndex], true);
+    }
+}
+
+// Draw every instance through the batched instance renderer
+void RunBatchedScene(int InstanceCount)
+{
+    RenderModelInstances(&BushBatch, InstanceTransforms, InstanceCount, true);
+}
+
+// Rebuild every instance's matrix through a float SRT matrix that is then converted to fixed-point (the
+// ENGINE_FLOAT_MATRICES path), and draw the instances without letting the renderer rebuild them again
+void RunFloatSRTScene(int InstanceCount)
+{
+    long long StartTicks = timer_ticks();
+
+    for (int InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+    {
+        struct ModelTransform* Transform = &InstanceTransforms[InstanceIndex];
+        T3DMat4 FloatMatrix = CreateSRTMatrix(Transform->Position, Transform->Rotation, Transform->Scale);
+
+        t3d_mat4_to_fixed(&Transform->ModelMatrixFPCache, &FloatMatrix);
+    }
+
+    TransformTicks += timer_ticks() - StartTicks;
+    TransformCount += InstanceCount;
+    RenderModelInstances(&BushBatch, InstanceTransforms, InstanceCount, false);
+}
+
+// Rebuild every instance's matrix by writing the fixed-point SRT matrix directly (the default path),
+// and draw the instances without letting the renderer rebuild them again
+void RunDirectSRTScene(int InstanceCount)
+{
+    long long StartTicks = timer_ticks();
+
+    for (int InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+    {
+        struct ModelTransform* Transform = &InstanceTransforms[InstanceIndex];
+
+        CreateSRTMatrixFP(&Transform->ModelMatrixFPCache, Transform->Position, Transform->Rotation, Transform->Scale);
+    }
+
+    TransformTicks += timer_ticks() - StartTicks;
+    TransformCount += InstanceCount;
+    RenderModelInstances(&BushBatch, InstanceTransforms, InstanceCount, false);
+}
+
+// Lay the instances out in a square grid centered on the origin
+void SetupInstanceTransforms()
+{
+    int GridSize = (int)ceilf(sqrtf(BENCHMARK_MAX_INSTANCES));
+
+    for (int InstanceIndex = 0; InstanceIndex < BENCHMARK_MAX_INSTANCES; InstanceIndex++)
+    {
+        struct ModelTransform NewTransform = CreateNewModelTransform();
+
+        NewTransform.Position = (T3DVec3){{((InstanceIndex % GridSize) - (GridSize / 2.0f)) * 12.0f, -100.0f, ((InstanceIndex / GridSize) - (GridSize / 2.0f)) * 12.0f}};
+        NewTransform.Scale = (T3DVec3){{0.05f, 0.05f, 0.05f}};
+
+        InstanceTransforms[InstanceIndex] = NewTransform;
+    }
+}
+
+// Print the results of every scene to the debug console
+void PrintResults()
+{
+    DebugPrint("[INFO] >> Benchmark results:\n", MINIMAL);
+
+    for (int SceneIndex = 0; SceneIndex < SceneCount; SceneIndex++)
+    {
+        DebugPrint("    %s x%d: submit=%fus, frame=%fms", MINIMAL, Scenes[SceneIndex].Name, Scenes[SceneIndex].InstanceCount, Results[SceneIndex].SubmitMicroseconds, Results[SceneIndex].FrameMilliseconds);
+
+        if (Results[SceneIndex].CyclesPerTransform > 0.0f)
+        {
+            DebugPrint(", %f cycles per transform", MINIMAL, Results[SceneIndex].CyclesPerTransform);
+        }
+
+        DebugPrint("\n", MINIMAL);
+    }
+}
+
+int main()
+{
+    // Every benchmarked instance borrows a matrix each frame, plus a few for the rest of the scene
+    MatrixPoolMatricesPerFrame = BENCHMARK_MAX_INSTANCES + 16;
+    SetDebugMode(MINIMAL);
+    InitSystem(RESOLUTION_320x240, DEPTH_16_BPP, 2, FILTERS_RESAMPLE_ANTIALIAS, true);
+
+    debugf("\n[== N64 Game Engine Benchmark ==]\n");
+    RegisterFontBasic("rom:/DEBUG.font64", COLOR_WHITE, COLOR_TRANSPARENT, 1);
+
+    Viewport = t3d_viewport_create();
+    CamProps = DefaultCameraProperties;
+    CamProps.Position = (T3DVec3){{0.0f, 60.0f, 160.0f}};
+    CamProps.Target = (T3DVec3){{0.0f, -100.0f, 0.0f}};
+    CamProps.FOV = 90.0f;
+    CameraClipping[1] = 500.0f;
+
+    CreateNewModelObject(&FloorObject, "rom:/Floor.t3dm");
+    FloorObject.Transform.Position = (T3DVec3){{0.0f, -100.0f, 0.0f}};
+    FloorObject.Transform.Scale = (T3DVec3){{0.75f, 1.0f, 0.75f}};
+
+    BushModel = t3d_model_load("rom:/StretchyBush.t3dm");
+    CreateInstanceBatch(&BushBatch, BushModel, BENCHMARK_MAX_INSTANCES);
+    SetupInstanceTransforms();
+    t3d_vec3_norm(&SunDirection);
+
+    while (true)
+    {
+        UpdateViewport(&Viewport, CamProps);
+        GetControllerInput(&Input, JOYPAD_PORT_1);
+
+        // Restart the benchmark when A is pressed
+        if (Input.PressedButtons.a)
+        {
+            CurrentScene = 0;
+            SceneFrame = 0;
+        }
+
+        StartFrame();
+        Start3DMode(&Viewport);
+        ClearScreen(COLOR_BLACK);
+        UpdateLightProperties(1, GlobalLightColor, SunColor, &SunDirection);
+        RenderModel(&FloorObject, true);
+
+        if (CurrentScene < SceneCount)
+        {
+            struct BenchmarkScene* Scene = &Scenes[CurrentScene];
+            long long StartTicks = timer_ticks();
+
+            Scene->Run(Scene->InstanceCount);
+
+            // The first few frames are skipped so caches and the display queue can settle
+            if (SceneFrame < BENCHMARK_WARMUP_FRAMES)
+            {
+                TransformTicks = 0;
+                TransformCount = 0;
+            }
+            else
+            {
+                SubmitTicks += timer_ticks() - StartTicks;
+                FrameTimeTotal += DeltaTime;
+            }
+
+            SceneFrame++;
+
+            if (SceneFrame >= BENCHMARK_WARMUP_FRAMES + BENCHMARK_FRAMES)
+            {
+                Results[CurrentScene].SubmitMicroseconds = TIMER_MICROS_LL(SubmitTicks) / (float)BENCHMARK_FRAMES;
+                Results[CurrentScene].FrameMilliseconds = (FrameTimeTotal / BENCHMARK_FRAMES) * 1000.0f;
+                Results[CurrentScene].CyclesPerTransform = TransformCount > 0 ? (TransformTicks * CPU_CYCLES_PER_TIMER_TICK) / (float)TransformCount : 0.0f;
+                SubmitTicks = 0;
+                TransformTicks = 0;
+                TransformCount = 0;
+                FrameTimeTotal = 0.0f;
+                SceneFrame = 0;
+                CurrentScene++;
+
+                if (CurrentScene >= SceneCount)
+                {
+                    PrintResults();
+                }
+            }
+        }
+
+        Start2DMode();
+
+        if (CurrentScene < SceneCount)
+        {
+            rdpq_text_printf(NULL, 1, 5, 12, "RUNNING: %s x%d (%d/%d)", Scenes[CurrentScene].Name, Scenes[CurrentScene].InstanceCount, CurrentScene + 1, SceneCount);
+            rdpq_text_printf(NULL, 1, 5, 24, "FPS: %.2f", FPS);
+        }
+        else
+        {
+            rdpq_text_printf(NULL, 1, 5, 12, "RESULTS (A TO RESTART)");
+
+            for (int SceneIndex = 0; SceneIndex < SceneCount; SceneIndex++)
+            {
+                if (Results[SceneIndex].CyclesPerTransform > 0.0f)
+                {
+                    rdpq_text_printf(NULL, 1, 5, 30 + (SceneIndex * 12), "%s x%d: %.1f cycles per matrix", Scenes[SceneIndex].Name, Scenes[SceneIndex].InstanceCount, Results[SceneIndex].CyclesPerTransform);
+                }
+                else
+                {
+                    rdpq_text_printf(NULL, 1, 5, 30 + (SceneIndex * 12), "%s x%d: %.1fus submit, %.2fms frame", Scenes[SceneIndex].Name, Scenes[SceneIndex].InstanceCount, Results[SceneIndex].SubmitMicroseconds, Results[SceneIndex].FrameMilliseconds);
+                }
+            }
+        }
+
+        EndFrame(&CamProps);
+    }
+
+    t3d_destroy();
+    return 0;
+}
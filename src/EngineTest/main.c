@@ -13,27 +13,45 @@
 #include <t3d/t3dmodel.h>
 #include <t3d/t3ddebug.h>
 #include "../N64GameEngine.h"
+#include "../AssetManager.h"
 #include "../ColorUtils.h"
+#include "../HUD.h"
+#include "../LevelStreaming.h"
 #include "../MathUtils.h"
+#include "../MemoryUtils.h"
+#include "../Profiler.h"
+#include "../SpriteBatch.h"
 #include "../TextUtils.h"
+#include "../Trace.h"
 #include "../Globals.h"
 
 
+/* DEFINITIONS */
+#define CAM_TEXT_STYLE 1 // The debug font style the camera mode text is drawn with
+#define STREAMING_ZONE_COUNT 4 // The number of zones around the scene that are streamed in and out
+
+
 /* VARIABLES */
 struct CameraProperties CamProps;
 struct ControllerState Input;
 struct ModelTransform CameraForwardTransform;
-struct ModelTransform FenceModelTransforms[4];
-struct ModelTransform BushModelTransforms[4];
+struct LODModelObject FenceObjects[4];
+struct ModelObject BushObjects[4];
 struct ModelTransform HeadModelTransforms[4];
 struct ModelObject FloorObject;
 struct ModelObject N64Object;
+struct StaticBatch LevelBatch;
+struct HUD MinimalDebugHUD;
+struct HUD FullDebugHUD;
+struct SpriteAtlas UIAtlas;
+struct LevelStreamer ZoneStreamer;
+struct StreamingZone StreamingZones[STREAMING_ZONE_COUNT];
+struct ModelTransform ZoneBushTransforms[STREAMING_ZONE_COUNT];
+struct AtlasRegion* UIIcons[4];
 T3DViewport Viewport;
 rdpq_font_t* DebugFont;
-rdpq_font_t* CamFont;
 T3DModel* HeadModels[4];
-T3DModel* AxisModel;
-T3DModel* BushModel;
+T3DModel* AxisModel = NULL;
 T3DVec3 CamForwardDirection;
 T3DVec3 SunDirection = {{-1.0f, 1.0f, 1.0f}};
 color_t SkyColors[3] = {(color_t){0x94, 0xC4, 0xF2, 0xFF}, (color_t){0x45, 0x4A, 0x73, 0xFF}, (color_t){0x0A, 0x09, 0x13, 0xFF}};
@@ -42,12 +60,17 @@ color_t SkyColor = (color_t){0x94, 0xC4, 0xF2, 0xFF};
 uint8_t SunColors[3][4] = {{0xFB, 0xFF, 0xCD, 0xFF}, {0x4E, 0x54, 0x82, 0xFF}, {0x1D, 0x19, 0x36, 0xFF}};
 uint8_t GlobalLightColor[4] = {0x50, 0x50, 0x64, 0xFF};
 uint8_t SunColor[4] = {0xFB, 0xFF, 0xCD, 0xFF};
+char* UIIconNames[4] = {"red", "green", "blue", "yeller"};
+char* ZoneNames[STREAMING_ZONE_COUNT] = {"North", "East", "South", "West"};
+char* ZoneSpritePaths[STREAMING_ZONE_COUNT] = {"rom:/Pikachu.sprite", "rom:/Checkerboard.sprite", "rom:/Grass.sprite", "rom:/XYZRepresentation.sprite"};
 char* HeadModelPaths[4] = {"rom:/Pikachu.t3dm", "rom:/Mario.t3dm", "rom:/Link.t3dm", "rom:/FoxMcCloud.t3dm"};
 char* CamModeDisplayText = "-- CAMERA MODE --";
 char* CameraModeStr = "Orbit";
-float FencePositions[4][2] = {{175.0f, 175.0f}, {175.0f, -175.0f}, {-175.0f, -175.0f}, {-175.0f, 175.0f}};
+float FencePositions[4][3] = {{0.0f, 200.0f, 0.0f}, {200.0f, 0.0f, 90.0f}, {0.0f, -200.0f, 0.0f}, {-200.0f, 0.0f, 90.0f}};
+float FenceLODDistances[2] = {150.0f, 275.0f};
 float BushPositions[4][2] = {{175.0f, 175.0f}, {175.0f, -175.0f}, {-175.0f, -175.0f}, {-175.0f, 175.0f}};
 float HeadPositions[4][2] = {{175.0f, 175.0f}, {175.0f, -175.0f}, {-175.0f, -175.0f}, {-175.0f, 175.0f}};
+float ZoneCenters[STREAMING_ZONE_COUNT][2] = {{0.0f, -300.0f}, {300.0f, 0.0f}, {0.0f, 300.0f}, {-300.0f, 0.0f}};
 float CameraControlSpeed = 50.0f;
 float InstalledMemoryKB = 0.0f;
 float CamTextTimeLeft = 0.0f;
@@ -60,9 +83,89 @@ int PreviousTimeColor = 0;
 int CameraMode = 0;
 int DebugMode = 1;
 int TimeColor = 1;
+int GameProfileZone;
+int MemoryField, UptimeField, FPSField;
+int StickNormField, StickField, CamTargetField, CamPositionField, CamForwardField, CamRightField, CamUpField;
+int MatrixField, ModelsField, TextCacheField, SpritesField, ProfileField, ArenaField;
 
 
 /* FUNCTIONS */
+// Called once the axis model has been loaded in the background
+void OnAxisModelLoaded(int Handle, void* Asset, void* UserData)
+{
+    AxisModel = Asset;
+    DebugPrint("[INFO] >> The axis model finished loading.\n", MINIMAL);
+}
+
+// Called once all of a streaming zone's assets have loaded. Its bush is placed in the middle of the zone
+void OnZoneLoaded(struct StreamingZone* Zone)
+{
+    struct ModelTransform* BushTransform = Zone->UserData;
+
+    *BushTransform = CreateNewModelTransform();
+    BushTransform->Position = (T3DVec3){{(Zone->BoundsMin.v[0] + Zone->BoundsMax.v[0]) / 2.0f, -100.0f, (Zone->BoundsMin.v[2] + Zone->BoundsMax.v[2]) / 2.0f}};
+    BushTransform->Scale = (T3DVec3){{0.5f, 0.5f, 0.5f}};
+}
+
+// Called right before a streaming zone's assets are released. The bush's transform uses the model's shared render
+// block, which is freed along with the model, so the transform is reset
+void OnZoneUnloaded(struct StreamingZone* Zone)
+{
+    *(struct ModelTransform*)Zone->UserData = CreateNewModelTransform();
+}
+
+// Set up the zones around the scene. Every zone has the bush model (which is shared between all of them, and with the
+// static level geometry) and a sprite of its own, which is shown in the debug overlay while the zone is resident. The
+// budget only fits the shared assets and two of the sprites, so the orbiting camera loads, prefetches and evicts zones
+void CreateStreamingZones()
+{
+    uint32_t LargestSpriteBytes = 0;
+
+    for (int ZoneIndex = 0; ZoneIndex < STREAMING_ZONE_COUNT; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &StreamingZones[ZoneIndex];
+        float CenterX = ZoneCenters[ZoneIndex][0];
+        float CenterZ = ZoneCenters[ZoneIndex][1];
+
+        CreateStreamingZone(Zone, ZoneNames[ZoneIndex], (T3DVec3){{CenterX - 50.0f, -150.0f, CenterZ - 50.0f}}, (T3DVec3){{CenterX + 50.0f, 50.0f, CenterZ + 50.0f}});
+        AddZoneAsset(Zone, "rom:/StretchyBush.t3dm", ASSET_MODEL);
+        AddZoneAsset(Zone, ZoneSpritePaths[ZoneIndex], ASSET_SPRITE);
+        Zone->OnLoaded = OnZoneLoaded;
+        Zone->OnUnloaded = OnZoneUnloaded;
+        Zone->UserData = &ZoneBushTransforms[ZoneIndex];
+
+        LargestSpriteBytes = MAX(LargestSpriteBytes, Zone->Assets[1].Bytes);
+    }
+
+    InitLevelStreamer(&ZoneStreamer, StreamingZones, STREAMING_ZONE_COUNT);
+    ZoneStreamer.LoadRadius = 200.0f;
+    ZoneStreamer.BudgetBytes = StreamingZones[0].Assets[0].Bytes + (LargestSpriteBytes * 2);
+}
+
+// Lay out the debug overlay's labels once. Only the fields' values are updated (and laid out again) while running
+void CreateDebugHUDs()
+{
+    CreateHUD(&MinimalDebugHUD, 6);
+    MemoryField = AddHUDLabeledField(&MinimalDebugHUD, "MEM USED: ", 1, 5, 12, 34, HEAPSTATS_UPDATE_MS);
+    UptimeField = AddHUDLabeledField(&MinimalDebugHUD, "UPTIME: ", 1, 5, 24, 12, 100);
+    FPSField = AddHUDLabeledField(&MinimalDebugHUD, "FPS: ", 1, 5, 36, 34, 250);
+
+    CreateHUD(&FullDebugHUD, 26);
+    StickNormField = AddHUDLabeledField(&FullDebugHUD, "STICK NORM: ", 1, 5, 48, 32, HUD_REFRESH_EVERY_FRAME);
+    StickField = AddHUDLabeledField(&FullDebugHUD, "STICK: ", 1, 5, 60, 20, HUD_REFRESH_EVERY_FRAME);
+    CamTargetField = AddHUDLabeledField(&FullDebugHUD, "CAM TGT: ", 1, 5, 72, 28, HUD_REFRESH_EVERY_FRAME);
+    CamPositionField = AddHUDLabeledField(&FullDebugHUD, "CAM POS: ", 1, 5, 84, 28, HUD_REFRESH_EVERY_FRAME);
+    CamForwardField = AddHUDLabeledField(&FullDebugHUD, "CAM FWD: ", 1, 5, 96, 28, HUD_REFRESH_EVERY_FRAME);
+    CamRightField = AddHUDLabeledField(&FullDebugHUD, "CAM RGT: ", 1, 5, 108, 28, HUD_REFRESH_EVERY_FRAME);
+    CamUpField = AddHUDLabeledField(&FullDebugHUD, "CAM UP: ", 1, 5, 120, 28, HUD_REFRESH_EVERY_FRAME);
+    MatrixField = AddHUDLabeledField(&FullDebugHUD, "MTX REBUILDS: ", 1, 5, 132, 20, HUD_REFRESH_EVERY_FRAME);
+    ModelsField = AddHUDLabeledField(&FullDebugHUD, "MODELS: ", 1, 5, 144, 24, HUD_REFRESH_EVERY_FRAME);
+    TextCacheField = AddHUDLabeledField(&FullDebugHUD, "TEXT CACHE: ", 1, 5, 156, 28, 250);
+    SpritesField = AddHUDLabeledField(&FullDebugHUD, "SPRITES: ", 1, 5, 168, 24, 250);
+    ProfileField = AddHUDLabeledField(&FullDebugHUD, "CPU/RDP: ", 1, 5, 180, 30, 250);
+    ArenaField = AddHUDLabeledField(&FullDebugHUD, "FRAME ARENA: ", 1, 5, 192, 24, 250);
+}
+
 int main()
 {
     // Set the engine's debug mode to output all available debug information
@@ -77,7 +180,14 @@ int main()
 
     DebugPrint("[INFO] >> Registering fonts...\n", MINIMAL);
     DebugFont = RegisterFontBasic("rom:/DEBUG.font64", COLOR_WHITE, COLOR_TRANSPARENT, 1);
-    CamFont = RegisterFontBasic("rom:/DEBUG.font64", COLOR_WHITE, COLOR_TRANSPARENT, 2);
+
+    // The camera mode text fades with its own style, so the font only has to be loaded once
+    rdpq_font_style(DebugFont, CAM_TEXT_STYLE, &(rdpq_fontstyle_t){
+        .color = COLOR_WHITE,
+    });
+
+    CreateDebugHUDs();
+    GameProfileZone = RegisterProfileZone("Game", COLOR_YELLOW);
     
     // Set up the camera and the viewport
     DebugPrint("[INFO] >> Creating T3D viewport...\n", MINIMAL);
@@ -93,15 +203,28 @@ int main()
     // This is commented out because I haven't yet decided what models to use
     /*for (int ModelIndex = 0; ModelIndex < 4; ModelIndex++)
     {
-        HeadModels[ModelIndex] = t3d_model_load(HeadModelPaths[ModelIndex]);
+        HeadModels[ModelIndex] = LoadModel(HeadModelPaths[ModelIndex]);
     }*/
 
     DebugPrint("[INFO] >> Loading models...\n", MINIMAL);
     CreateNewModelObject(&FloorObject, "rom:/Floor.t3dm");
     CreateNewModelObject(&N64Object, "rom:/N64.t3dm");
 
-    AxisModel = t3d_model_load("rom:/XYZ.t3dm");
-    BushModel = t3d_model_load("rom:/StretchyBush.t3dm");
+    // The axis model is only drawn when it's toggled on, so it's loaded over the first few frames instead of at startup
+    RequestAsset("rom:/XYZ.t3dm", ASSET_MODEL, OnAxisModelLoaded, NULL);
+
+    // The UI icons are packed into one atlas at build time, so they're a single file and can share TMEM loads
+    DebugPrint("[INFO] >> Loading UI atlas...\n", MINIMAL);
+    LoadSpriteAtlas(&UIAtlas, "rom:/UI.sprite", "rom:/UI.atlas");
+
+    for (int IconIndex = 0; IconIndex < 4; IconIndex++)
+    {
+        UIIcons[IconIndex] = FindAtlasRegion(&UIAtlas, UIIconNames[IconIndex]);
+        assertf(UIIcons[IconIndex] != NULL, "The UI atlas doesn't have a \"%s\" icon!", UIIconNames[IconIndex]);
+    }
+
+    DebugPrint("[INFO] >> Setting up streaming zones...\n", MINIMAL);
+    CreateStreamingZones();
 
     DebugPrint("[INFO] >> Setting up transforms...\n", MINIMAL);
 
@@ -119,34 +242,49 @@ int main()
 
     t3d_vec3_norm(&SunDirection);
 
-    // Create transforms for the 4 bush models
+    // Create objects for the 4 bush models. They're all created from the same path, so they share one model and render block
     for (int BMIndex = 0; BMIndex < 4; BMIndex++)
     {
-        struct ModelTransform NewTransform = CreateNewModelTransform();
-
-        NewTransform.Position = (T3DVec3){{BushPositions[BMIndex][0], -100.0f, BushPositions[BMIndex][1]}};
-        NewTransform.Scale = (T3DVec3){{0.5f, 0.5f, 0.5f}};
+        CreateNewModelObject(&BushObjects[BMIndex], "rom:/StretchyBush.t3dm");
+        BushObjects[BMIndex].Transform.Position = (T3DVec3){{BushPositions[BMIndex][0], -100.0f, BushPositions[BMIndex][1]}};
+        BushObjects[BMIndex].Transform.Scale = (T3DVec3){{0.5f, 0.5f, 0.5f}};
+    }
 
-        BushModelTransforms[BMIndex] = NewTransform;
+    // Create the fences around the edge of the floor. Their lower detail levels are generated at build time (see the Makefile),
+    // and the orbiting camera is always close to some fences and far from others
+    for (int FenceIndex = 0; FenceIndex < 4; FenceIndex++)
+    {
+        CreateNewLODModelObject(&FenceObjects[FenceIndex], "rom:/Fence", FenceLODDistances, 3);
+        FenceObjects[FenceIndex].Transform.Position = (T3DVec3){{FencePositions[FenceIndex][0], -100.0f, FencePositions[FenceIndex][1]}};
+        FenceObjects[FenceIndex].Transform.Rotation = (T3DVec3){{0.0f, FencePositions[FenceIndex][2], 0.0f}};
+        FenceObjects[FenceIndex].Transform.Scale = (T3DVec3){{0.5f, 0.5f, 0.5f}};
     }
 
+    // The floor and the bushes never move, so they're baked into a single render block
+    DebugPrint("[INFO] >> Baking static level geometry...\n", MINIMAL);
+    struct ModelObject* StaticObjects[5] = {&FloorObject, &BushObjects[0], &BushObjects[1], &BushObjects[2], &BushObjects[3]};
+    CreateStaticBatch(&LevelBatch, StaticObjects, 5);
+
     DebugPrint("[INFO] >> Starting game loop...\n", MINIMAL);
 
     while (true)
     {
+        // Everything up to StartFrame is the game's own update, so it gets its own profiler zone
+        PROFILE_BEGIN(GameProfileZone);
+
         // Update the viewport (screen projection and camera transform)
         UpdateViewport(&Viewport, CamProps);
 
         // You should try to update the scene before you start drawing or after the frame ends (where possible) to
-        // avoid potential graphical issues. Note that T3D draws asynchronously, so you can't use one matrix to render multiple
-        // models if the matrix changes more than once per frame.
+        // avoid potential graphical issues. Note that T3D draws asynchronously, so every draw borrows its own matrix from
+        // the engine's matrix pool. This means one transform can be changed and drawn multiple times per frame.
         ModelAngle += 1.5f * DeltaTime;
         CamForwardDirection = CamProps.ForwardVector;
-        N64Object.Transform.Rotation.v[0] = ModelAngle * -RotationSpeed;
-        N64Object.Transform.Rotation.v[1] = ModelAngle * -RotationSpeed;
+        SetTransformRotation(&N64Object.Transform, (T3DVec3){{ModelAngle * -RotationSpeed, ModelAngle * -RotationSpeed, 0.0f}});
 
         ScaleFloat3(CamForwardDirection.v, 100.0f);
         t3d_vec3_add(&CameraForwardTransform.Position, &CamProps.Target, &CamForwardDirection);
+        MarkTransformDirty(&CameraForwardTransform);
 
         // Slowly fade the sky and global light colors to sunset
         Lerp1DUint8Array(SunColor, SunColors[PreviousTimeColor], SunColors[TimeColor], 4, SkyLerpProgress);
@@ -280,8 +418,28 @@ int main()
             }
 
             DebugPrint("[INFO] >> Set camera mode to \"%s\" (mode %d).\n", MINIMAL, CameraModeStr, CameraMode);
+            TRACE_MINIMAL("Camera mode %d at %v\n", CameraMode, CamProps.Position);
+        }
+
+        // Load the zones around the camera (and the ones it's heading towards) now that it has moved
+        UpdateLevelStreamer(&ZoneStreamer, &CamProps);
+
+        // Write the profiler's kept frames to the console if the L button is pressed, and the memory usage of every
+        // subsystem (and the streaming zones) if the R button is pressed
+        if (Input.PressedButtons.l)
+        {
+            DumpProfiler();
         }
 
+        if (Input.PressedButtons.r)
+        {
+            PrintMemoryReport();
+            PrintAssetReport();
+            PrintLevelStreamerReport(&ZoneStreamer);
+        }
+
+        PROFILE_END(GameProfileZone);
+
         // Start the frame and enter 3D mode
         // All 3D graphics operations should almost always take place in 3D mode
         StartFrame();
@@ -290,20 +448,27 @@ int main()
         UpdateLightProperties(1, GlobalLightColor, SunColor, &SunDirection);
 
         // Render models
-        RenderModel(FloorObject, true);
-        RenderModel(N64Object, true);
-        
-        for (int ModelIndex = 0; ModelIndex < 4; ModelIndex++)
+        RenderStaticBatch(&LevelBatch);
+        RenderModel(&N64Object, true);
+
+        for (int FenceIndex = 0; FenceIndex < 4; FenceIndex++)
         {
-            //RenderModel(FenceModel, &FenceModelTransforms[ModelIndex], true);
-            RenderModelWithTransform(BushModel, &BushModelTransforms[ModelIndex], true);
+            RenderLODModel(&FenceObjects[FenceIndex], true);
+        }
+
+        for (int ZoneIndex = 0; ZoneIndex < STREAMING_ZONE_COUNT; ZoneIndex++)
+        {
+            if (StreamingZones[ZoneIndex].State == ZONE_RESIDENT)
+            {
+                RenderModelWithTransform(StreamingZones[ZoneIndex].Assets[0].Asset, &ZoneBushTransforms[ZoneIndex], true);
+            }
         }
 
         // Draw the Axis ("XYZ") model if it's enabled. The depth buffer is cleared before the model is rendered so it will appear in top of
         // everything. It's important that you only clear the depth buffer and draw this model AFTER everything else has been drawn, because
         // otherwise everything would be drawn with no depth. Z sorting is enabled because that causes an issue when rendering the model
         // where the X axis arrow would be visible through the Z axis arrow.
-        if (DrawAxisModel == true)
+        if (DrawAxisModel == true && AxisModel != NULL)
         {
             t3d_screen_clear_depth();
             RenderModelWithTransform(AxisModel, &CameraForwardTransform, true);
@@ -328,29 +493,58 @@ int main()
 
             CamTextTimeLeft -= 1.0f * DeltaTime; 
             
-            rdpq_font_style(CamFont, 0, &(rdpq_fontstyle_t){
+            rdpq_font_style(DebugFont, CAM_TEXT_STYLE, &(rdpq_fontstyle_t){
                 .color = CamModeColor,
             });
 
-            rdpq_text_printf(NULL, 2, 160 - (PixelStrWidth(CamModeDisplayText, 1) / 2.0f), 180, CamModeDisplayText);
-            rdpq_text_printf(NULL, 2, 160 - (PixelStrWidth(CameraModeStr, 1) / 2.0f), 195, CameraModeStr);
+            // These labels rarely change, so DrawString reuses their cached layouts instead of building them every frame
+            DrawStringStyled(CamModeDisplayText, 1, CAM_TEXT_STYLE, 160 - (PixelStrWidth(CamModeDisplayText, 1) / 2.0f), 180);
+            DrawStringStyled(CameraModeStr, 1, CAM_TEXT_STYLE, 160 - (PixelStrWidth(CameraModeStr, 1) / 2.0f), 195);
         }
 
+        // The debug overlay is retained, so fields are only formatted at their refresh rate and only laid out when their text changes
         if (DebugMode > 0)
         {
-            rdpq_text_printf(NULL, 1, 5, 12, "MEM USED: %.2f / %.2f KB (%.2f%%)", HeapStats.used / 1024.0f, InstalledMemoryKB, UsedMemPercentage * 100.0f);
-            rdpq_text_printf(NULL, 1, 5, 24, "UPTIME: %.2fs", UptimeMilliseconds() / 1000.0f);
-            rdpq_text_printf(NULL, 1, 5, 36, "FPS: %.2f/%.2f (%.1f%%, DT=%.3fms)", FPS, TargetFPS, ((float)FPS / TargetFPS) * 100.0f, DeltaTime);
+            UpdateHUDField(&MinimalDebugHUD, MemoryField, "%.2f / %.2f KB (%.2f%%)", HeapStats.used / 1024.0f, InstalledMemoryKB, UsedMemPercentage * 100.0f);
+            UpdateHUDField(&MinimalDebugHUD, UptimeField, "%.1fs", UptimeMilliseconds() / 1000.0f);
+            UpdateHUDField(&MinimalDebugHUD, FPSField, "%.2f/%.2f (%.1f%%, DT=%.3fms)", FPS, TargetFPS, ((float)FPS / TargetFPS) * 100.0f, DeltaTime);
+            DrawHUD(&MinimalDebugHUD);
             
             if (DebugMode == 2)
             {
-                rdpq_text_printf(NULL, 1, 5, 48, "STICK NORM: X=%f || Y=%f", Input.StickStateNormalized[0], Input.StickStateNormalized[1]);
-                rdpq_text_printf(NULL, 1, 5, 60, "STICK: X=%d || Y=%d", Input.StickState[0], Input.StickState[1]);
-                rdpq_text_printf(NULL, 1, 5, 72, "CAM TGT: %.3f, %.3f, %.3f", CamProps.Target.v[0], CamProps.Target.v[1], CamProps.Target.v[2]);
-                rdpq_text_printf(NULL, 1, 5, 84, "CAM POS: %.3f, %.3f, %.3f", CamProps.Position.v[0], CamProps.Position.v[1], CamProps.Position.v[2]);
-                rdpq_text_printf(NULL, 1, 5, 96, "CAM FWD: %.3f, %.3f, %.3f", CamProps.ForwardVector.v[0], CamProps.ForwardVector.v[1], CamProps.ForwardVector.v[2]);
-                rdpq_text_printf(NULL, 1, 5, 108, "CAM RGT: %.3f, %.3f, %.3f", CamProps.RightVector.v[0], CamProps.RightVector.v[1], CamProps.RightVector.v[2]);
-                rdpq_text_printf(NULL, 1, 5, 120, "CAM UP: %.3f, %.3f, %.3f", CamProps.UpVector.v[0], CamProps.UpVector.v[1], CamProps.UpVector.v[2]);
+                UpdateHUDField(&FullDebugHUD, StickNormField, "X=%f || Y=%f", Input.StickStateNormalized[0], Input.StickStateNormalized[1]);
+                UpdateHUDField(&FullDebugHUD, StickField, "X=%d || Y=%d", Input.StickState[0], Input.StickState[1]);
+                UpdateHUDField(&FullDebugHUD, CamTargetField, "%.3f, %.3f, %.3f", CamProps.Target.v[0], CamProps.Target.v[1], CamProps.Target.v[2]);
+                UpdateHUDField(&FullDebugHUD, CamPositionField, "%.3f, %.3f, %.3f", CamProps.Position.v[0], CamProps.Position.v[1], CamProps.Position.v[2]);
+                UpdateHUDField(&FullDebugHUD, CamForwardField, "%.3f, %.3f, %.3f", CamProps.ForwardVector.v[0], CamProps.ForwardVector.v[1], CamProps.ForwardVector.v[2]);
+                UpdateHUDField(&FullDebugHUD, CamRightField, "%.3f, %.3f, %.3f", CamProps.RightVector.v[0], CamProps.RightVector.v[1], CamProps.RightVector.v[2]);
+                UpdateHUDField(&FullDebugHUD, CamUpField, "%.3f, %.3f, %.3f", CamProps.UpVector.v[0], CamProps.UpVector.v[1], CamProps.UpVector.v[2]);
+                UpdateHUDField(&FullDebugHUD, MatrixField, "%d (SKIPPED %d)", MatrixRebuilds, SkippedMatrixRebuilds);
+                UpdateHUDField(&FullDebugHUD, ModelsField, "%d VISIBLE, %d CULLED", VisibleModelCount, CulledModelCount);
+                UpdateHUDField(&FullDebugHUD, TextCacheField, "%d HITS, %d MISSES, %d B", TextCacheHits, TextCacheMisses, TextCacheBytesUsed);
+
+                for (int IconIndex = 0; IconIndex < 4; IconIndex++)
+                {
+                    QueueAtlasSprite(&UIAtlas, UIIcons[IconIndex], 243 + (IconIndex * 18), 217, 0.5f, 0);
+                }
+
+                // Each resident zone's sprite is shown above the icons, shrunk to the same size
+                for (int ZoneIndex = 0; ZoneIndex < STREAMING_ZONE_COUNT; ZoneIndex++)
+                {
+                    sprite_t* ZoneSprite = StreamingZones[ZoneIndex].Assets[1].Asset;
+
+                    if (StreamingZones[ZoneIndex].State == ZONE_RESIDENT)
+                    {
+                        QueueSpriteRegion(ZoneSprite, 0, 0, ZoneSprite->width, ZoneSprite->height, 243 + (ZoneIndex * 18), 199, 16.0f / MAX(ZoneSprite->width, ZoneSprite->height), 0);
+                    }
+                }
+
+                FlushSpriteBatch();
+                UpdateHUDField(&FullDebugHUD, SpritesField, "%d DRAWS, %d UPLOADS", SpriteBatchDraws, SpriteBatchUploads);
+                UpdateHUDField(&FullDebugHUD, ProfileField, "%.2f / %.2f MS", GetProfileFrameMS(), GetProfileRDPBusyMS());
+                UpdateHUDField(&FullDebugHUD, ArenaField, "%d / %d B (PEAK %d)", (int)FrameArenaUsed, (int)FrameArenaCapacity, (int)FrameArenaPeak);
+                DrawHUD(&FullDebugHUD);
+                DrawProfilerGraph(5, 204, 128, 32);
             }
         }
         
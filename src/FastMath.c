@@ -0,0 +1,85 @@
+/* N64 GAME ENGINE */
+// Fast math file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include "FastMath.h"
+
+
+/* DEFINITIONS */
+// pi / 2 split into 3 parts (Cody-Waite). The first two only use a few mantissa bits, so multiplying them by the
+// quadrant is exact and the range reduction doesn't lose precision for large angles
+#define PIO2_PART1 1.5703125f
+#define PIO2_PART2 4.837512969970703125e-4f
+#define PIO2_PART3 7.54978995489188216e-8f
+#define TWO_OVER_PI 0.636619772367581f
+
+
+/* FUNCTIONS */
+// ----- Trigonometry -----
+// Calculate the sine and cosine of an angle (in radians) at the same time, in single precision. The angle is reduced to [-pi/4, pi/4] and both values come from short
+// minimax polynomials (the same ones Cephes' sinf / cosf use), so there are no double precision operations or libm
+// calls. The maximum absolute error is below 1e-7 for |Radians| <= 1000 and below 1e-6 for |Radians| <= 100000
+// (measured by Utilities/FastMathBenchmark)
+void FastSinCos(float Radians, float* Sin, float* Cos)
+{
+    // Find the closest multiple of pi / 2 (the quadrant) and the remaining angle
+    float Quadrant = (float)(int)(Radians * TWO_OVER_PI + (Radians >= 0.0f ? 0.5f : -0.5f));
+    float Reduced = ((Radians - (Quadrant * PIO2_PART1)) - (Quadrant * PIO2_PART2)) - (Quadrant * PIO2_PART3);
+    float Squared = Reduced * Reduced;
+
+    float SinValue = Reduced + (Reduced * Squared * (-1.6666654611e-1f + Squared * (8.3321608736e-3f + Squared * -1.9515295891e-4f)));
+    float CosValue = 1.0f - (0.5f * Squared) + (Squared * Squared * (4.166664568298827e-2f + Squared * (-1.388731625493765e-3f + Squared * 2.443315711809948e-5f)));
+
+    switch ((int)Quadrant & 3)
+    {
+        case 0:
+            *Sin = SinValue;
+            *Cos = CosValue;
+            break;
+
+        case 1:
+            *Sin = CosValue;
+            *Cos = -SinValue;
+            break;
+
+        case 2:
+            *Sin = -SinValue;
+            *Cos = -CosValue;
+            break;
+
+        case 3:
+            *Sin = -CosValue;
+            *Cos = SinValue;
+            break;
+    }
+}
+
+// Calculate the sine and cosine of an angle in degrees
+void FastSinCosDeg(float Degrees, float* Sin, float* Cos)
+{
+    FastSinCos(FAST_DEG_TO_RAD(Degrees), Sin, Cos);
+}
+
+// Calculate the sine of an angle (in radians)
+float FastSin(float Radians)
+{
+    float Sin, Cos;
+
+    FastSinCos(Radians, &Sin, &Cos);
+    return Sin;
+}
+
+// Calculate the cosine of an angle (in radians)
+float FastCos(float Radians)
+{
+    float Sin, Cos;
+
+    FastSinCos(Radians, &Sin, &Cos);
+    return Cos;
+}
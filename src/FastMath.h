@@ -0,0 +1,29 @@
+/* N64 GAME ENGINE */
+// Fast math header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+//
+// These are plain C with no LibDragon or libm calls, so the N64 build and the host build of
+// Utilities/FastMathBenchmark run the exact same code
+
+
+// Define FASTMATH_H if it hasn't been already
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+
+/* DEFINITIONS */
+#define FAST_PI 3.14159265358979f
+#define FAST_DEG_TO_RAD(Degrees) ((Degrees) * 0.0174532925199433f)
+
+
+/* FUNCTIONS */
+// ----- Trigonometry -----
+void FastSinCos(float Radians, float* Sin, float* Cos);
+void FastSinCosDeg(float Degrees, float* Sin, float* Cos);
+float FastSin(float Radians);
+float FastCos(float Radians);
+#endif
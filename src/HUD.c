@@ -0,0 +1,184 @@
+/* N64 GAME ENGINE */
+// HUD file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libdragon.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "Profiler.h"
+#include "TextUtils.h"
+#include "HUD.h"
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+// Creates an empty HUD that can hold up to Capacity labels and fields
+void CreateHUD(struct HUD* Hud, int Capacity)
+{
+    Hud->Elements = TaggedMalloc(sizeof(struct HUDElement) * Capacity, MEMORY_TAG_TEXT);
+    Hud->ElementCount = 0;
+    Hud->Capacity = Capacity;
+    Hud->LayoutsBuilt = 0;
+
+    assertf(Hud->Elements != NULL, "Failed to allocate a HUD with %d elements!", Capacity);
+}
+
+// Frees a HUD's elements and their layouts
+void FreeHUD(struct HUD* Hud)
+{
+    for (int ElementIndex = 0; ElementIndex < Hud->ElementCount; ElementIndex++)
+    {
+        TaggedFree(Hud->Elements[ElementIndex].Paragraph);
+        TaggedFree(Hud->Elements[ElementIndex].Text);
+    }
+
+    TaggedFree(Hud->Elements);
+    Hud->Elements = NULL;
+    Hud->ElementCount = 0;
+    Hud->Capacity = 0;
+}
+
+// Lay out an element's current text again, over its old layout. Nothing is allocated
+void LayoutHUDElement(struct HUD* Hud, struct HUDElement* Element)
+{
+    PROFILE_BEGIN(PROFILE_ZONE_TEXT);
+
+    BuildParagraphInBuffer(Element->Paragraph, Element->ParagraphCapacity, Element->Text, Element->FontID, NULL);
+    Element->IsLaidOut = true;
+    Hud->LayoutsBuilt++;
+    PROFILE_END(PROFILE_ZONE_TEXT);
+}
+
+// Add an empty element to a HUD and return its index. Its paragraph is allocated here, with room for TextBytes - 1
+// characters of text
+int AddHUDElement(struct HUD* Hud, int FontID, int XPos, int YPos, int TextBytes)
+{
+    assertf(Hud->ElementCount < Hud->Capacity, "The HUD is full (%d elements)!", Hud->Capacity);
+
+    struct HUDElement* NewElement = &Hud->Elements[Hud->ElementCount];
+
+    NewElement->ParagraphCapacity = (TextBytes - 1) + PARAGRAPH_EXTRA_CHARS;
+    NewElement->Paragraph = TaggedMalloc(sizeof(rdpq_paragraph_t) + (NewElement->ParagraphCapacity * sizeof(rdpq_paragraph_char_t)), MEMORY_TAG_TEXT);
+    NewElement->Text = TaggedCalloc(TextBytes, 1, MEMORY_TAG_TEXT);
+    NewElement->NextRefresh = 0;
+    NewElement->RefreshMS = HUD_REFRESH_EVERY_FRAME;
+    NewElement->SlotChars = 0;
+    NewElement->FontID = FontID;
+    NewElement->XPos = XPos;
+    NewElement->YPos = YPos;
+    NewElement->IsLabel = false;
+    NewElement->IsLaidOut = false;
+
+    assertf(NewElement->Paragraph != NULL && NewElement->Text != NULL, "Failed to allocate HUD text!");
+    return Hud->ElementCount++;
+}
+
+// Adds a static label to a HUD and lays it out. Labels are never laid out again
+int AddHUDLabel(struct HUD* Hud, char* Text, int FontID, int XPos, int YPos)
+{
+    int LabelIndex = AddHUDElement(Hud, FontID, XPos, YPos, strlen(Text) + 1);
+    struct HUDElement* Label = &Hud->Elements[LabelIndex];
+
+    strcpy(Label->Text, Text);
+    Label->IsLabel = true;
+    LayoutHUDElement(Hud, Label);
+
+    return LabelIndex;
+}
+
+// Adds a field to a HUD. Its text is always padded or cut to SlotChars characters, and a new value is only
+// formatted once every RefreshMS milliseconds (HUD_REFRESH_EVERY_FRAME checks every frame)
+int AddHUDField(struct HUD* Hud, int FontID, int XPos, int YPos, int SlotChars, int RefreshMS)
+{
+    assertf(SlotChars > 0 && SlotChars <= HUD_MAX_FIELD_CHARS, "Invalid HUD field width (%d characters)!", SlotChars);
+
+    int FieldIndex = AddHUDElement(Hud, FontID, XPos, YPos, SlotChars + 1);
+
+    Hud->Elements[FieldIndex].SlotChars = SlotChars;
+    Hud->Elements[FieldIndex].RefreshMS = RefreshMS;
+
+    return FieldIndex;
+}
+
+// Adds a static label and a field that starts right after it, and returns the field's index
+int AddHUDLabeledField(struct HUD* Hud, char* Label, int FontID, int XPos, int YPos, int SlotChars, int RefreshMS)
+{
+    AddHUDLabel(Hud, Label, FontID, XPos, YPos);
+    return AddHUDField(Hud, FontID, XPos + PixelStrWidth(Label, FontID), YPos, SlotChars, RefreshMS);
+}
+
+// ----- Update functions -----
+// Check if a field is due for a new value. This can be used to skip gathering expensive values
+bool IsHUDFieldDue(struct HUD* Hud, int FieldIndex)
+{
+    return UptimeMilliseconds() >= Hud->Elements[FieldIndex].NextRefresh;
+}
+
+// Format a new value into a field, if its refresh time has come. The field is only laid out again if the text
+// it displays actually changed, so most calls only cost a compare (or nothing at all between refreshes)
+void UpdateHUDField(struct HUD* Hud, int FieldIndex, const char* Format, ...)
+{
+    struct HUDElement* Field = &Hud->Elements[FieldIndex];
+    long long CurrentTime = UptimeMilliseconds();
+    char NewText[HUD_MAX_FIELD_CHARS + 1];
+
+    assertf(Field->IsLabel == false, "HUD element %d is a label, not a field!", FieldIndex);
+
+    if (CurrentTime < Field->NextRefresh)
+    {
+        return;
+    }
+
+    Field->NextRefresh = CurrentTime + Field->RefreshMS;
+
+    va_list ArgList;
+    va_start(ArgList, Format);
+    int TextLength = vsnprintf(NewText, Field->SlotChars + 1, Format, ArgList);
+    va_end(ArgList);
+
+    // Pad the text out to the slot's width, so the field's layout always covers the same area
+    for (int CharIndex = MAX(TextLength, 0); CharIndex < Field->SlotChars; CharIndex++)
+    {
+        NewText[CharIndex] = ' ';
+    }
+
+    NewText[Field->SlotChars] = '\0';
+
+    if (Field->IsLaidOut == true && strcmp(NewText, Field->Text) == 0)
+    {
+        return;
+    }
+
+    strcpy(Field->Text, NewText);
+    LayoutHUDElement(Hud, Field);
+}
+
+// ----- Drawing functions -----
+// Draw every label and field of a HUD. This only renders the existing layouts, so it should be called in 2D mode
+void DrawHUD(struct HUD* Hud)
+{
+    PROFILE_BEGIN(PROFILE_ZONE_TEXT);
+
+    for (int ElementIndex = 0; ElementIndex < Hud->ElementCount; ElementIndex++)
+    {
+        struct HUDElement* Element = &Hud->Elements[ElementIndex];
+
+        if (Element->IsLaidOut == true)
+        {
+            rdpq_paragraph_render(Element->Paragraph, Element->XPos, Element->YPos);
+        }
+    }
+
+    PROFILE_END(PROFILE_ZONE_TEXT);
+}
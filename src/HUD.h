@@ -0,0 +1,67 @@
+/* N64 GAME ENGINE */
+// HUD header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define HUD_H if it hasn't been already
+#ifndef HUD_H
+#define HUD_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define HUD_MAX_FIELD_CHARS 48 // The widest a HUD field's slot can be, in characters
+#define HUD_REFRESH_EVERY_FRAME 0 // A field refresh rate that checks for a new value every frame
+
+
+/* VARIABLES */
+// A single piece of HUD text. Labels are laid out once when they're added, fields are formatted
+// into a fixed-width slot and only laid out again when their displayed text changes. Paragraph is allocated
+// with the element, big enough for its longest text, and every layout is built into it in place
+struct HUDElement
+{
+    rdpq_paragraph_t* Paragraph;
+    char* Text;
+    long long NextRefresh;
+    int RefreshMS;
+    int SlotChars;
+    int ParagraphCapacity;
+    int FontID;
+    int XPos;
+    int YPos;
+    bool IsLabel;
+    bool IsLaidOut;
+};
+
+// A retained-mode HUD. Elements are drawn in the order they were added
+struct HUD
+{
+    struct HUDElement* Elements;
+    int ElementCount;
+    int Capacity;
+    int LayoutsBuilt;
+};
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+void CreateHUD(struct HUD* Hud, int Capacity);
+void FreeHUD(struct HUD* Hud);
+int AddHUDLabel(struct HUD* Hud, char* Text, int FontID, int XPos, int YPos);
+int AddHUDField(struct HUD* Hud, int FontID, int XPos, int YPos, int SlotChars, int RefreshMS);
+int AddHUDLabeledField(struct HUD* Hud, char* Label, int FontID, int XPos, int YPos, int SlotChars, int RefreshMS);
+
+// ----- Update functions -----
+bool IsHUDFieldDue(struct HUD* Hud, int FieldIndex);
+void UpdateHUDField(struct HUD* Hud, int FieldIndex, const char* Format, ...);
+
+// ----- Drawing functions -----
+void DrawHUD(struct HUD* Hud);
+#endif
@@ -0,0 +1,462 @@
+/* N64 GAME ENGINE */
+// Level streaming file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <string.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include "N64GameEngine.h"
+#include "AssetManager.h"
+#include "LevelStreaming.h"
+#include "MathUtils.h"
+
+
+/* VARIABLES */
+struct LevelStreamer* ActiveLevelStreamer = NULL;
+const char* ZoneStateNames[] = {"UNLOADED", "LOADING", "RESIDENT"};
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Called when one of a zone's assets finishes loading
+void OnZoneAssetLoaded(int Handle, void* Asset, void* UserData)
+{
+    struct StreamingZone* Zone = UserData;
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        if (Zone->Assets[AssetIndex].LoadHandle == Handle)
+        {
+            Zone->Assets[AssetIndex].Asset = Asset;
+            Zone->Assets[AssetIndex].LoadHandle = 0;
+            Zone->PendingAssets--;
+            return;
+        }
+    }
+}
+
+// Check if one of the loaded (or loading) zones before ZoneLimit needs an asset
+bool IsAssetHeldByZones(struct LevelStreamer* Streamer, const char* Path, int ZoneLimit)
+{
+    for (int ZoneIndex = 0; ZoneIndex < ZoneLimit; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->State == ZONE_UNLOADED)
+        {
+            continue;
+        }
+
+        for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+        {
+            if (Zone->Assets[AssetIndex].Path == Path || strcmp(Zone->Assets[AssetIndex].Path, Path) == 0)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// Get the size of one of a zone's assets. Loaded assets use the size the asset manager measured, the others their estimate
+uint32_t GetZoneAssetBytes(struct ZoneAsset* Asset)
+{
+    struct AssetEntry* Entry = Asset->Asset != NULL ? FindAssetByData(Asset->Asset) : FindAsset(Asset->Path);
+
+    return Entry != NULL ? Entry->Bytes + Entry->RenderBlockBytes : Asset->Bytes;
+}
+
+// Add up the size of every asset the loaded (and loading) zones need. Assets shared between zones are only counted for
+// the first zone that needs them. This only has to be done when a zone's state changes
+void UpdateResidentBytes(struct LevelStreamer* Streamer)
+{
+    Streamer->ResidentBytes = 0;
+
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->State == ZONE_UNLOADED)
+        {
+            continue;
+        }
+
+        for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+        {
+            if (IsAssetHeldByZones(Streamer, Zone->Assets[AssetIndex].Path, ZoneIndex) == false)
+            {
+                Streamer->ResidentBytes += GetZoneAssetBytes(&Zone->Assets[AssetIndex]);
+            }
+        }
+    }
+}
+
+// Mark a zone whose assets have all loaded as resident. Its assets' sizes are measured now, replacing the estimates it
+// was loaded with
+void FinishZoneLoad(struct LevelStreamer* Streamer, struct StreamingZone* Zone)
+{
+    Zone->Bytes = 0;
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        Zone->Assets[AssetIndex].Bytes = GetZoneAssetBytes(&Zone->Assets[AssetIndex]);
+        Zone->Bytes += Zone->Assets[AssetIndex].Bytes;
+    }
+
+    Streamer->ZonesLoaded++;
+    Zone->State = ZONE_RESIDENT;
+    UpdateResidentBytes(Streamer);
+
+    DebugPrint("[INFO] >> Zone \"%s\" is resident (%d bytes).\n", ALL, Zone->Name, (int)Zone->Bytes);
+
+    if (Zone->OnLoaded != NULL)
+    {
+        Zone->OnLoaded(Zone);
+    }
+}
+
+// The memory pressure hook the active level streamer registers. Zones can only be freed if they aren't in range
+uint32_t HandleStreamingMemoryPressure(uint32_t BytesToFree)
+{
+    if (ActiveLevelStreamer == NULL)
+    {
+        return 0;
+    }
+
+    return EvictZones(ActiveLevelStreamer, BytesToFree, false);
+}
+
+// ----- Creation functions -----
+// Create a zone covering the area between BoundsMin and BoundsMax. Its assets are added with AddZoneAsset
+void CreateStreamingZone(struct StreamingZone* Zone, char* Name, T3DVec3 BoundsMin, T3DVec3 BoundsMax)
+{
+    memset(Zone, 0, sizeof(struct StreamingZone));
+
+    Zone->Name = Name;
+    Zone->BoundsMin = BoundsMin;
+    Zone->BoundsMax = BoundsMax;
+    Zone->State = ZONE_UNLOADED;
+}
+
+// Add an asset to a zone's list. The path isn't copied, so it has to stay valid. The asset's size is estimated from its
+// file right away, so the zone can be budgeted before it has ever been loaded
+void AddZoneAsset(struct StreamingZone* Zone, char* Path, enum AssetTypes Type)
+{
+    assertf(Zone->AssetCount < ZONE_MAX_ASSETS, "Zone \"%s\" has too many assets (%d max)!", Zone->Name, ZONE_MAX_ASSETS);
+    assertf(Zone->State == ZONE_UNLOADED, "Assets can't be added to zone \"%s\" while it's loaded!", Zone->Name);
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        assertf(strcmp(Zone->Assets[AssetIndex].Path, Path) != 0, "Zone \"%s\" already has \"%s\"!", Zone->Name, Path);
+    }
+
+    uint32_t Bytes = GetAssetFileSize(Path);
+
+    Zone->Assets[Zone->AssetCount++] = (struct ZoneAsset){Path, NULL, Bytes, 0, Type};
+    Zone->Bytes += Bytes;
+}
+
+// Set up a level streamer for a set of zones. The streaming budget is LEVEL_STREAMING_BUDGET_FRACTION of the heap,
+// and the streamer becomes the engine's memory pressure hook, so CheckAvailableMemory evicts zones instead of
+// stopping the game. Only one streamer can be the hook at a time
+void InitLevelStreamer(struct LevelStreamer* Streamer, struct StreamingZone* Zones, int ZoneCount)
+{
+    memset(Streamer, 0, sizeof(struct LevelStreamer));
+
+    Streamer->Zones = Zones;
+    Streamer->ZoneCount = ZoneCount;
+    Streamer->BudgetBytes = HeapStats.total * LEVEL_STREAMING_BUDGET_FRACTION;
+    Streamer->LoadRadius = LEVEL_STREAMING_DEFAULT_LOAD_RADIUS;
+    Streamer->PrefetchSeconds = LEVEL_STREAMING_DEFAULT_PREFETCH_SECONDS;
+
+    ActiveLevelStreamer = Streamer;
+    MemoryPressureHook = HandleStreamingMemoryPressure;
+
+    DebugPrint("[INFO] >> Level streamer set up with %d zones (%d byte budget).\n", ALL, ZoneCount, (int)Streamer->BudgetBytes);
+}
+
+// Unload every zone of a level streamer. If it's the memory pressure hook, the hook is removed
+void FreeLevelStreamer(struct LevelStreamer* Streamer)
+{
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        UnloadZone(Streamer, &Streamer->Zones[ZoneIndex]);
+    }
+
+    if (ActiveLevelStreamer == Streamer)
+    {
+        ActiveLevelStreamer = NULL;
+        MemoryPressureHook = NULL;
+    }
+}
+
+// ----- Zone functions -----
+// Start loading a zone's assets with the async loader. The zone is counted against the budget right away, with its
+// assets' estimated sizes. Returns false if the async loader doesn't have room for every asset right now
+bool LoadZone(struct LevelStreamer* Streamer, struct StreamingZone* Zone)
+{
+    if (Zone->State != ZONE_UNLOADED)
+    {
+        return true;
+    }
+
+    if (PendingAssetLoads + Zone->AssetCount > ASSET_LOAD_QUEUE_SIZE)
+    {
+        return false;
+    }
+
+    DebugPrint("[INFO] >> Loading zone \"%s\" (%d assets).\n", ALL, Zone->Name, Zone->AssetCount);
+    Zone->State = ZONE_LOADING;
+    Zone->PendingAssets = Zone->AssetCount;
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        Zone->Assets[AssetIndex].Asset = NULL;
+        Zone->Assets[AssetIndex].LoadHandle = RequestAsset(Zone->Assets[AssetIndex].Path, Zone->Assets[AssetIndex].Type, OnZoneAssetLoaded, Zone);
+    }
+
+    UpdateResidentBytes(Streamer);
+    return true;
+}
+
+// Unload a zone, releasing its assets (or canceling their loads if it's still loading). Returns the number of bytes
+// that were actually freed, which doesn't include assets that are still needed by other zones (or anything else)
+uint32_t UnloadZone(struct LevelStreamer* Streamer, struct StreamingZone* Zone)
+{
+    uint32_t BytesFreed = 0;
+
+    if (Zone->State == ZONE_UNLOADED)
+    {
+        return 0;
+    }
+
+    if (Zone->State == ZONE_RESIDENT && Zone->OnUnloaded != NULL)
+    {
+        Zone->OnUnloaded(Zone);
+    }
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        struct ZoneAsset* Asset = &Zone->Assets[AssetIndex];
+
+        if (Asset->LoadHandle != 0)
+        {
+            CancelAssetLoad(Asset->LoadHandle);
+        }
+
+        if (Asset->Asset != NULL)
+        {
+            BytesFreed += ReleaseAsset(Asset->Asset);
+        }
+
+        Asset->Asset = NULL;
+        Asset->LoadHandle = 0;
+    }
+
+    DebugPrint("[INFO] >> Unloaded zone \"%s\" (%d / %d bytes freed).\n", ALL, Zone->Name, (int)BytesFreed, (int)Zone->Bytes);
+    Zone->PendingAssets = 0;
+    Zone->State = ZONE_UNLOADED;
+    UpdateResidentBytes(Streamer);
+
+    return BytesFreed;
+}
+
+// Get the number of bytes loading a zone would add to the streamer's resident bytes. Assets another loaded (or
+// loading) zone already needs don't cost anything
+uint32_t GetZoneLoadCost(struct LevelStreamer* Streamer, struct StreamingZone* Zone)
+{
+    uint32_t Cost = 0;
+
+    for (int AssetIndex = 0; AssetIndex < Zone->AssetCount; AssetIndex++)
+    {
+        if (IsAssetHeldByZones(Streamer, Zone->Assets[AssetIndex].Path, Streamer->ZoneCount) == false)
+        {
+            Cost += GetZoneAssetBytes(&Zone->Assets[AssetIndex]);
+        }
+    }
+
+    return Cost;
+}
+
+// Find the zone that should be unloaded next, or NULL if every loaded zone is in range. Zones that aren't being
+// prefetched go first, and within those the zones that were visible the longest time ago. If KeepPrefetched is set,
+// prefetched zones are never picked
+struct StreamingZone* FindEvictionVictim(struct LevelStreamer* Streamer, bool KeepPrefetched)
+{
+    struct StreamingZone* Victim = NULL;
+
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->State == ZONE_UNLOADED || Zone->InRange == true || (KeepPrefetched == true && Zone->Prefetch == true))
+        {
+            continue;
+        }
+
+        if (Victim == NULL || Zone->Prefetch < Victim->Prefetch || (Zone->Prefetch == Victim->Prefetch && Zone->LastVisibleFrame < Victim->LastVisibleFrame))
+        {
+            Victim = Zone;
+        }
+    }
+
+    return Victim;
+}
+
+// Unload zones that aren't in range until at least BytesToFree bytes have been freed (or there's nothing left to
+// unload), and return the number of bytes freed. Only assets whose last reference was released count as freed, so
+// unloading a zone whose assets are all shared with other zones (or held by anything else) doesn't count towards
+// BytesToFree. This is what the memory pressure hook uses, since it needs heap memory back. See FindEvictionVictim
+// for the order zones are unloaded in
+uint32_t EvictZones(struct LevelStreamer* Streamer, uint32_t BytesToFree, bool KeepPrefetched)
+{
+    uint32_t BytesFreed = 0;
+
+    while (BytesFreed < BytesToFree)
+    {
+        struct StreamingZone* Victim = FindEvictionVictim(Streamer, KeepPrefetched);
+
+        if (Victim == NULL)
+        {
+            break;
+        }
+
+        Streamer->ZonesEvicted++;
+        BytesFreed += UnloadZone(Streamer, Victim);
+    }
+
+    return BytesFreed;
+}
+
+// Unload zones that aren't in range until loading Zone would fit in the streamer's budget (or until the budget is met,
+// if Zone is NULL). Unlike EvictZones this goes by ResidentBytes, so zones whose assets are also held outside of the
+// streamer still count. Zone's cost is checked again after every eviction, since unloading a zone that shared assets
+// with it makes it cost more. Returns true if the budget has room
+bool EvictZonesToBudget(struct LevelStreamer* Streamer, struct StreamingZone* Zone, bool KeepPrefetched)
+{
+    while (Streamer->ResidentBytes + (Zone == NULL ? 0 : GetZoneLoadCost(Streamer, Zone)) > Streamer->BudgetBytes)
+    {
+        struct StreamingZone* Victim = FindEvictionVictim(Streamer, KeepPrefetched);
+
+        if (Victim == NULL)
+        {
+            return false;
+        }
+
+        Streamer->ZonesEvicted++;
+        UnloadZone(Streamer, Victim);
+    }
+
+    return true;
+}
+
+// Get the distance from a point to the closest point of a zone's bounds (0 if the point is inside of them)
+float GetDistanceToZone(struct StreamingZone* Zone, T3DVec3 Point)
+{
+    T3DVec3 Closest;
+
+    for (int Axis = 0; Axis < 3; Axis++)
+    {
+        Closest.v[Axis] = MIN(MAX(Point.v[Axis], Zone->BoundsMin.v[Axis]), Zone->BoundsMax.v[Axis]);
+    }
+
+    return t3d_vec3_distance(&Point, &Closest);
+}
+
+// ----- Update functions -----
+// Load the zones around the camera and the zones it's heading towards, and evict zones if the budget is exceeded.
+// This should be called once per frame, after the camera has moved. Zones finish loading over the next few frames
+// (see UpdateAssetLoads), and their OnLoaded callbacks are called from here once they have
+void UpdateLevelStreamer(struct LevelStreamer* Streamer, struct CameraProperties* CamProps)
+{
+    T3DVec3 Position = CamProps->Position;
+
+    // The camera's velocity is smoothed, so a single jerky frame doesn't change which zones are prefetched
+    if (Streamer->HasCameraPosition == true && DeltaTime > 0.0f)
+    {
+        for (int Axis = 0; Axis < 3; Axis++)
+        {
+            float FrameVelocity = (Position.v[Axis] - Streamer->LastCameraPosition.v[Axis]) / DeltaTime;
+
+            Streamer->Velocity.v[Axis] = LerpFloat(Streamer->Velocity.v[Axis], FrameVelocity, LEVEL_STREAMING_VELOCITY_SMOOTHING);
+            Streamer->PredictedPosition.v[Axis] = Position.v[Axis] + (Streamer->Velocity.v[Axis] * Streamer->PrefetchSeconds);
+        }
+    }
+    else
+    {
+        Streamer->PredictedPosition = Position;
+    }
+
+    Streamer->LastCameraPosition = Position;
+    Streamer->HasCameraPosition = true;
+
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        Zone->InRange = GetDistanceToZone(Zone, Position) <= Streamer->LoadRadius;
+        Zone->Prefetch = Zone->InRange == false && GetDistanceToZone(Zone, Streamer->PredictedPosition) <= Streamer->LoadRadius;
+
+        if (Zone->InRange == true && (ViewFrustumIsValid == false || t3d_frustum_vs_aabb(&ViewFrustum, &Zone->BoundsMin, &Zone->BoundsMax) == true))
+        {
+            Zone->LastVisibleFrame = FrameCount;
+        }
+    }
+
+    // Zones in range are always loaded, even if nothing can be evicted to make room for them
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->InRange == true && Zone->State == ZONE_UNLOADED)
+        {
+            EvictZonesToBudget(Streamer, Zone, false);
+            LoadZone(Streamer, Zone);
+        }
+    }
+
+    // Prefetched zones are only loaded if they fit, and never push out other prefetched zones
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->Prefetch == true && Zone->State == ZONE_UNLOADED && EvictZonesToBudget(Streamer, Zone, true) == true)
+        {
+            LoadZone(Streamer, Zone);
+        }
+    }
+
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        if (Zone->State == ZONE_LOADING && Zone->PendingAssets == 0)
+        {
+            FinishZoneLoad(Streamer, Zone);
+        }
+    }
+
+    // An asset's real size is only known once it's loaded, so the budget can still be exceeded here
+    EvictZonesToBudget(Streamer, NULL, false);
+}
+
+// Print every zone's state and size, and the streamer's budget
+void PrintLevelStreamerReport(struct LevelStreamer* Streamer)
+{
+    DebugPrint("[INFO] >> Level streamer report (%d / %d bytes resident, %d loads, %d evictions):\n", MINIMAL, (int)Streamer->ResidentBytes, (int)Streamer->BudgetBytes, Streamer->ZonesLoaded, Streamer->ZonesEvicted);
+
+    for (int ZoneIndex = 0; ZoneIndex < Streamer->ZoneCount; ZoneIndex++)
+    {
+        struct StreamingZone* Zone = &Streamer->Zones[ZoneIndex];
+
+        DebugPrint("    %s: %s, %d bytes, last visible on frame %d%s%s\n", MINIMAL, Zone->Name, ZoneStateNames[Zone->State], (int)Zone->Bytes, Zone->LastVisibleFrame, Zone->InRange == true ? " (in range)" : "", Zone->Prefetch == true ? " (prefetching)" : "");
+    }
+}
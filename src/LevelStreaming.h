@@ -0,0 +1,119 @@
+/* N64 GAME ENGINE */
+// Level streaming header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+//
+// A level is split into zones, each with a bounding box and a list of the assets it needs. UpdateLevelStreamer loads
+// (through the async loader) every zone within LoadRadius of the camera, and prefetches the zones the camera is
+// heading towards. Zones are never unloaded just because the camera left them, they stay resident until memory is
+// needed: either the resident zones go over the streaming budget, or CheckAvailableMemory reports memory pressure.
+// Then the zones that were visible the longest time ago are evicted first. Zones within LoadRadius are never evicted
+//
+// Each asset's size starts out as the size of its file (see GetAssetFileSize), and is replaced by the memory it actually
+// used (measured from the heap by the asset manager) once it has been loaded. A zone is charged against the budget as
+// soon as its load starts. Assets shared between zones are only counted once, and evicting a zone only frees the
+// assets that no other loaded zone needs. Assets that are also held outside of the streamer (like models the game
+// acquired itself) are counted too, even though unloading their zones doesn't free them
+
+
+// Define LEVELSTREAMING_H if it hasn't been already
+#ifndef LEVELSTREAMING_H
+#define LEVELSTREAMING_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+#include "AssetManager.h"
+
+
+/* DEFINITIONS */
+#define ZONE_MAX_ASSETS 16 // The maximum number of assets a zone can list
+#define LEVEL_STREAMING_BUDGET_FRACTION 0.5f // The fraction of the heap the resident zones can use by default
+#define LEVEL_STREAMING_DEFAULT_LOAD_RADIUS 250.0f // The default distance from the camera zones are loaded within
+#define LEVEL_STREAMING_DEFAULT_PREFETCH_SECONDS 1.5f // How far ahead (in seconds of camera movement) zones are prefetched by default
+#define LEVEL_STREAMING_VELOCITY_SMOOTHING 0.1f // How quickly the camera's predicted velocity follows its actual velocity (0 - 1)
+
+
+/* VARIABLES */
+enum ZoneStates
+{
+    ZONE_UNLOADED,
+    ZONE_LOADING,
+    ZONE_RESIDENT
+};
+
+// An asset a zone needs. Asset is NULL until the zone has loaded it, and LoadHandle is its async load while it's loading.
+// Bytes is the asset's size (estimated until it has been loaded once)
+struct ZoneAsset
+{
+    char* Path;
+    void* Asset;
+    uint32_t Bytes;
+    int LoadHandle;
+    enum AssetTypes Type;
+};
+
+// A part of the level that's streamed in and out as a whole. OnLoaded is called once all of its assets are loaded, and
+// OnUnloaded right before they're released (so anything drawing them can be removed). Either callback can be NULL.
+// Bytes is the size of all of its assets, and InRange and Prefetch are set by UpdateLevelStreamer every frame
+struct StreamingZone
+{
+    char* Name;
+    struct ZoneAsset Assets[ZONE_MAX_ASSETS];
+    T3DVec3 BoundsMin;
+    T3DVec3 BoundsMax;
+    void (*OnLoaded)(struct StreamingZone* Zone);
+    void (*OnUnloaded)(struct StreamingZone* Zone);
+    void* UserData;
+    uint32_t Bytes;
+    int AssetCount;
+    int PendingAssets;
+    int LastVisibleFrame;
+    bool InRange;
+    bool Prefetch;
+    enum ZoneStates State;
+};
+
+// Streams a level's zones. Velocity is the camera's smoothed velocity (in units per second), which is used to predict
+// where it's going to be PrefetchSeconds from now. ResidentBytes is the size of every asset the resident and loading
+// zones need, with each asset counted once
+struct LevelStreamer
+{
+    struct StreamingZone* Zones;
+    T3DVec3 LastCameraPosition;
+    T3DVec3 Velocity;
+    T3DVec3 PredictedPosition;
+    uint32_t BudgetBytes;
+    uint32_t ResidentBytes;
+    float LoadRadius;
+    float PrefetchSeconds;
+    int ZoneCount;
+    int ZonesLoaded;
+    int ZonesEvicted;
+    bool HasCameraPosition;
+};
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+void CreateStreamingZone(struct StreamingZone* Zone, char* Name, T3DVec3 BoundsMin, T3DVec3 BoundsMax);
+void AddZoneAsset(struct StreamingZone* Zone, char* Path, enum AssetTypes Type);
+void InitLevelStreamer(struct LevelStreamer* Streamer, struct StreamingZone* Zones, int ZoneCount);
+void FreeLevelStreamer(struct LevelStreamer* Streamer);
+
+// ----- Zone functions -----
+bool LoadZone(struct LevelStreamer* Streamer, struct StreamingZone* Zone);
+uint32_t UnloadZone(struct LevelStreamer* Streamer, struct StreamingZone* Zone);
+uint32_t GetZoneLoadCost(struct LevelStreamer* Streamer, struct StreamingZone* Zone);
+struct StreamingZone* FindEvictionVictim(struct LevelStreamer* Streamer, bool KeepPrefetched);
+uint32_t EvictZones(struct LevelStreamer* Streamer, uint32_t BytesToFree, bool KeepPrefetched);
+bool EvictZonesToBudget(struct LevelStreamer* Streamer, struct StreamingZone* Zone, bool KeepPrefetched);
+float GetDistanceToZone(struct StreamingZone* Zone, T3DVec3 Point);
+
+// ----- Update functions -----
+void UpdateLevelStreamer(struct LevelStreamer* Streamer, struct CameraProperties* CamProps);
+void PrintLevelStreamerReport(struct LevelStreamer* Streamer);
+#endif
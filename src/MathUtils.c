@@ -8,9 +8,12 @@
 
 
 /* LIBRARIES */
+#include <math.h>
 #include <t3d/t3d.h>
 #include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
 #include "N64GameEngine.h"
+#include "FastMath.h"
 #include "MathUtils.h"
 
 
@@ -19,28 +22,19 @@
 // Rotate a vector3 by x degrees around the X axis
 void RotateVectorAxisX(T3DVec3* VectorToRotate, float Degrees)
 {
-    float Radians = T3D_DEG_TO_RAD(Degrees);
-
-    VectorToRotate->v[1] += VectorToRotate->v[1] * cos(Radians) - VectorToRotate->v[2] * sin(Radians);
-    VectorToRotate->v[2] += VectorToRotate->v[1] * sin(Radians) + VectorToRotate->v[2] * cos(Radians);
+    RotateVectorsAxisX(VectorToRotate, 1, Degrees);
 }
 
 // Rotate a vector3 by x degrees around the Y axis
 void RotateVectorAxisY(T3DVec3* VectorToRotate, float Degrees)
 {
-    float Radians = T3D_DEG_TO_RAD(Degrees);
-
-    VectorToRotate->v[0] += VectorToRotate->v[0] * cos(Radians) + VectorToRotate->v[2] * sin(Radians);
-    VectorToRotate->v[2] += -VectorToRotate->v[0] * sin(Radians) + VectorToRotate->v[2] * cos(Radians);
+    RotateVectorsAxisY(VectorToRotate, 1, Degrees);
 }
 
 // Rotate a vector3 by x degrees around the Z axis
 void RotateVectorAxisZ(T3DVec3* VectorToRotate, float Degrees)
 {
-    float Radians = T3D_DEG_TO_RAD(Degrees);
-
-    VectorToRotate->v[0] += VectorToRotate->v[0] * cos(Radians) - VectorToRotate->v[1] * sin(Radians);
-    VectorToRotate->v[1] += VectorToRotate->v[0] * sin(Radians) + VectorToRotate->v[1] * cos(Radians);
+    RotateVectorsAxisZ(VectorToRotate, 1, Degrees);
 }
 
 // Rotate a vector3 by x degrees
@@ -51,6 +45,70 @@ void RotateVector3ByDegrees(T3DVec3* Vector3ToRotate, T3DVec3 RotationDegrees)
     RotateVectorAxisZ(Vector3ToRotate, RotationDegrees.v[2]);
 }
 
+// Rotate an array of vector3s by x degrees around the X axis. The sine and cosine are only calculated once for the whole array
+void RotateVectorsAxisX(T3DVec3* Vectors, int VectorCount, float Degrees)
+{
+    float Sin, Cos;
+    FastSinCosDeg(Degrees, &Sin, &Cos);
+
+    for (int VectorIndex = 0; VectorIndex < VectorCount; VectorIndex++)
+    {
+        float Y = Vectors[VectorIndex].v[1];
+        float Z = Vectors[VectorIndex].v[2];
+
+        Vectors[VectorIndex].v[1] = Y * Cos - Z * Sin;
+        Vectors[VectorIndex].v[2] = Y * Sin + Z * Cos;
+    }
+}
+
+// Rotate an array of vector3s by x degrees around the Y axis. The sine and cosine are only calculated once for the whole array
+void RotateVectorsAxisY(T3DVec3* Vectors, int VectorCount, float Degrees)
+{
+    float Sin, Cos;
+    FastSinCosDeg(Degrees, &Sin, &Cos);
+
+    for (int VectorIndex = 0; VectorIndex < VectorCount; VectorIndex++)
+    {
+        float X = Vectors[VectorIndex].v[0];
+        float Z = Vectors[VectorIndex].v[2];
+
+        Vectors[VectorIndex].v[0] = X * Cos + Z * Sin;
+        Vectors[VectorIndex].v[2] = -X * Sin + Z * Cos;
+    }
+}
+
+// Rotate an array of vector3s by x degrees around the Z axis. The sine and cosine are only calculated once for the whole array
+void RotateVectorsAxisZ(T3DVec3* Vectors, int VectorCount, float Degrees)
+{
+    float Sin, Cos;
+    FastSinCosDeg(Degrees, &Sin, &Cos);
+
+    for (int VectorIndex = 0; VectorIndex < VectorCount; VectorIndex++)
+    {
+        float X = Vectors[VectorIndex].v[0];
+        float Y = Vectors[VectorIndex].v[1];
+
+        Vectors[VectorIndex].v[0] = X * Cos - Y * Sin;
+        Vectors[VectorIndex].v[1] = X * Sin + Y * Cos;
+    }
+}
+
+// Transform an array of points by a matrix (including its translation). Input and Output can be the same array
+void TransformPoints(T3DVec3* Output, T3DVec3* Input, int PointCount, T3DMat4* Matrix)
+{
+    for (int PointIndex = 0; PointIndex < PointCount; PointIndex++)
+    {
+        float X = Input[PointIndex].v[0];
+        float Y = Input[PointIndex].v[1];
+        float Z = Input[PointIndex].v[2];
+
+        for (int Axis = 0; Axis < 3; Axis++)
+        {
+            Output[PointIndex].v[Axis] = Matrix->m[0][Axis] * X + Matrix->m[1][Axis] * Y + Matrix->m[2][Axis] * Z + Matrix->m[3][Axis];
+        }
+    }
+}
+
 // Multiply the X, Y, and Z axes by a value
 void MultiplyAxesByFloat(T3DVec3* VectorToUpdate, T3DVec3 AxesToUpdate, float MultiplyValue)
 {
@@ -81,14 +139,16 @@ void OneifyVectorZeroes(T3DVec3* VectorToUpdate)
 T3DVec3 Vec3UnitCirclePointFromAngle(float HorizontalDegrees, float VerticalDegrees, T3DVec3 CenterPoint)
 {
     T3DVec3 ResultingVector;
-    float HRadians = T3D_DEG_TO_RAD(HorizontalDegrees);
-    float VRadians = T3D_DEG_TO_RAD(VerticalDegrees);
+    float HSin, HCos, VSin, VCos;
+
+    FastSinCosDeg(HorizontalDegrees, &HSin, &HCos);
+    FastSinCosDeg(VerticalDegrees, &VSin, &VCos);
 
     // Calculate x, y, z coordinates from spherical coordinates
-    ResultingVector.v[0] = CenterPoint.v[0] + cos(VRadians) * sin(HRadians);
-    ResultingVector.v[1] = CenterPoint.v[1] + sin(VRadians);
+    ResultingVector.v[0] = CenterPoint.v[0] + VCos * HSin;
+    ResultingVector.v[1] = CenterPoint.v[1] + VSin;
     //ResultingVector.v[2] = CenterPoint.v[2] + cos(HRadians);
-    ResultingVector.v[2] = CenterPoint.v[2] + cos(VRadians) * cos(HRadians);
+    ResultingVector.v[2] = CenterPoint.v[2] + VCos * HCos;
 
     return ResultingVector;
 }
@@ -141,10 +201,251 @@ T3DMat4 CreateSRTMatrix(T3DVec3 Position, T3DVec3 Rotation, T3DVec3 Scale)
     return NewMatrix;
 }
 
+// Create a fixed-point SRT matrix straight from position, rotation and scale values. This skips the intermediate
+// float matrix (and the float to fixed-point conversion pass) that CreateSRTMatrix + t3d_mat4_to_fixed would need
+void CreateSRTMatrixFP(T3DMat4FP* Matrix, T3DVec3 Position, T3DVec3 Rotation, T3DVec3 Scale)
+{
+    t3d_mat4fp_from_srt_euler(Matrix,
+        Scale.v,
+        Rotation.v,
+        Position.v
+    );
+}
+
+// Create a fixed-point SRT matrix from a quaternion rotation. Unlike the euler version, this doesn't need any trig
+void CreateSRTMatrixFromQuatFP(T3DMat4FP* Matrix, T3DVec3 Position, T3DQuat Rotation, T3DVec3 Scale)
+{
+    t3d_mat4fp_from_srt(Matrix,
+        Scale.v,
+        Rotation.v,
+        Position.v
+    );
+}
+
+// Get one element of a fixed-point (16.16) matrix as a float
+float GetFixedMatrixElement(const T3DMat4FP* Matrix, int Column, int Row)
+{
+    int32_t FixedValue = (int32_t)(((uint32_t)(uint16_t)Matrix->m[Column].i[Row] << 16) | Matrix->m[Column].f[Row]);
+
+    return FixedValue * (1.0f / 65536.0f);
+}
+
+// Get a transform's world space position from its cached fixed-point matrix (as of the last matrix rebuild)
+T3DVec3 GetTransformWorldPosition(struct ModelTransform* Transform)
+{
+    return (T3DVec3){{
+        GetFixedMatrixElement(&Transform->ModelMatrixFPCache, 3, 0),
+        GetFixedMatrixElement(&Transform->ModelMatrixFPCache, 3, 1),
+        GetFixedMatrixElement(&Transform->ModelMatrixFPCache, 3, 2)
+    }};
+}
+
+// Rebuild a transform's fixed-point matrix from its SRT data, but only if the SRT data changed since the last rebuild.
+// The fixed-point copy is copied into a matrix borrowed from the matrix pool when the transform is drawn. If
+// ENGINE_FLOAT_MATRICES is enabled, the float matrix is built first and converted, otherwise the fixed-point
+// matrix is written directly. RotationQuat is used instead of the euler angles if UseQuaternion is set
 void UpdateTransformMatrix(struct ModelTransform* Transform)
 {
-    Transform->ModelMatrix = CreateSRTMatrix(Transform->Position, Transform->Rotation, Transform->Scale);
-    t3d_mat4_to_fixed(Transform->ModelMatrixFP, &Transform->ModelMatrix);
+    if (Transform->BuiltGeneration == Transform->Generation)
+    {
+        SkippedMatrixRebuilds++;
+        return;
+    }
+
+#if ENGINE_FLOAT_MATRICES
+    if (Transform->UseQuaternion == true)
+    {
+        t3d_mat4_from_srt(&Transform->ModelMatrix, Transform->Scale.v, Transform->RotationQuat.v, Transform->Position.v);
+    }
+    else
+    {
+        Transform->ModelMatrix = CreateSRTMatrix(Transform->Position, Transform->Rotation, Transform->Scale);
+    }
+
+    t3d_mat4_to_fixed(&Transform->ModelMatrixFPCache, &Transform->ModelMatrix);
+#else
+    if (Transform->UseQuaternion == true)
+    {
+        CreateSRTMatrixFromQuatFP(&Transform->ModelMatrixFPCache, Transform->Position, Transform->RotationQuat, Transform->Scale);
+    }
+    else
+    {
+        CreateSRTMatrixFP(&Transform->ModelMatrixFPCache, Transform->Position, Transform->Rotation, Transform->Scale);
+    }
+#endif
+
+    Transform->BuiltGeneration = Transform->Generation;
+    MatrixRebuilds++;
+}
+
+// Calculate the world space bounding box of a model drawn with a fixed-point matrix. Only the model's local box center
+// is transformed, the half extents are the local half extents projected onto the world axes (Arvo's method)
+void GetModelWorldBounds(T3DModel* Model, const T3DMat4FP* Matrix, T3DVec3* BoundsMin, T3DVec3* BoundsMax)
+{
+    float LocalCenter[3];
+    float LocalExtents[3];
+
+    for (int Axis = 0; Axis < 3; Axis++)
+    {
+        LocalCenter[Axis] = (Model->aabbMin[Axis] + Model->aabbMax[Axis]) * 0.5f;
+        LocalExtents[Axis] = (Model->aabbMax[Axis] - Model->aabbMin[Axis]) * 0.5f;
+    }
+
+    for (int Axis = 0; Axis < 3; Axis++)
+    {
+        float WorldCenter = GetFixedMatrixElement(Matrix, 3, Axis);
+        float WorldExtent = 0.0f;
+
+        for (int Column = 0; Column < 3; Column++)
+        {
+            float Element = GetFixedMatrixElement(Matrix, Column, Axis);
+
+            WorldCenter += Element * LocalCenter[Column];
+            WorldExtent += ABS(Element) * LocalExtents[Column];
+        }
+
+        BoundsMin->v[Axis] = WorldCenter - WorldExtent;
+        BoundsMax->v[Axis] = WorldCenter + WorldExtent;
+    }
+}
+
+// Recalculate a transform's world space bounding box from a model's local bounding box, if the transform's matrix
+// was rebuilt since the last time. The fixed-point matrix is used so this works whether or not the float matrix is
+// compiled in
+void UpdateTransformBounds(struct ModelTransform* Transform, T3DModel* Model)
+{
+    if (Transform->BoundsModel == Model && Transform->BoundsGeneration == Transform->BuiltGeneration)
+    {
+        return;
+    }
+
+    GetModelWorldBounds(Model, &Transform->ModelMatrixFPCache, &Transform->BoundsMin, &Transform->BoundsMax);
+    Transform->BoundsModel = Model;
+    Transform->BoundsGeneration = Transform->BuiltGeneration;
+}
+
+// ----- Quaternion math -----
+// Get a quaternion with no rotation
+T3DQuat QuatIdentity()
+{
+    return (T3DQuat){{0.0f, 0.0f, 0.0f, 1.0f}};
+}
+
+// Create a quaternion that rotates by x degrees around an axis. The axis must be normalized
+T3DQuat QuatFromAxisAngle(T3DVec3 Axis, float Degrees)
+{
+    float HalfSin, HalfCos;
+    FastSinCosDeg(Degrees * 0.5f, &HalfSin, &HalfCos);
+
+    return (T3DQuat){{Axis.v[0] * HalfSin, Axis.v[1] * HalfSin, Axis.v[2] * HalfSin, HalfCos}};
+}
+
+// Create a quaternion from euler angles, using the same units and rotation order as ModelTransform.Rotation
+T3DQuat QuatFromEuler(T3DVec3 Rotation)
+{
+    T3DQuat NewQuat;
+
+    t3d_quat_from_euler(&NewQuat, Rotation.v);
+    return NewQuat;
+}
+
+// Combine two rotations (B is applied first, then A). This doesn't need any trig, so a rotation that is applied every
+// frame can be turned into a quaternion once and then multiplied in
+T3DQuat QuatMultiply(T3DQuat A, T3DQuat B)
+{
+    return (T3DQuat){{
+        A.v[3] * B.v[0] + A.v[0] * B.v[3] + A.v[1] * B.v[2] - A.v[2] * B.v[1],
+        A.v[3] * B.v[1] - A.v[0] * B.v[2] + A.v[1] * B.v[3] + A.v[2] * B.v[0],
+        A.v[3] * B.v[2] + A.v[0] * B.v[1] - A.v[1] * B.v[0] + A.v[2] * B.v[3],
+        A.v[3] * B.v[3] - A.v[0] * B.v[0] - A.v[1] * B.v[1] - A.v[2] * B.v[2]
+    }};
+}
+
+// Scale a quaternion back to unit length. Repeatedly multiplied quaternions slowly drift away from unit length,
+// so this should be called after every few multiplications
+T3DQuat QuatNormalize(T3DQuat Quat)
+{
+    float LengthSquared = Quat.v[0] * Quat.v[0] + Quat.v[1] * Quat.v[1] + Quat.v[2] * Quat.v[2] + Quat.v[3] * Quat.v[3];
+
+    if (LengthSquared <= 0.0f)
+    {
+        return QuatIdentity();
+    }
+
+    float InverseLength = 1.0f / sqrtf(LengthSquared);
+
+    return (T3DQuat){{Quat.v[0] * InverseLength, Quat.v[1] * InverseLength, Quat.v[2] * InverseLength, Quat.v[3] * InverseLength}};
+}
+
+// Get the dot product of two quaternions
+float QuatDot(T3DQuat A, T3DQuat B)
+{
+    return A.v[0] * B.v[0] + A.v[1] * B.v[1] + A.v[2] * B.v[2] + A.v[3] * B.v[3];
+}
+
+// Interpolate between two rotations by lerping and renormalizing (normalized lerp). This takes the shortest path
+// and is cheap, but its angular speed isn't constant. That's usually fine for small steps
+T3DQuat QuatNlerp(T3DQuat A, T3DQuat B, float Time)
+{
+    float Sign = QuatDot(A, B) < 0.0f ? -1.0f : 1.0f;
+    T3DQuat Result;
+
+    for (int Component = 0; Component < 4; Component++)
+    {
+        Result.v[Component] = A.v[Component] + ((B.v[Component] * Sign) - A.v[Component]) * Time;
+    }
+
+    return QuatNormalize(Result);
+}
+
+// Interpolate between two rotations at a constant angular speed (spherical lerp). Very close rotations fall back to
+// QuatNlerp, since they're nearly identical there and the slerp weights would divide by a tiny number
+T3DQuat QuatSlerp(T3DQuat A, T3DQuat B, float Time)
+{
+    float CosAngle = QuatDot(A, B);
+    float Sign = 1.0f;
+
+    if (CosAngle < 0.0f)
+    {
+        CosAngle = -CosAngle;
+        Sign = -1.0f;
+    }
+
+    if (CosAngle > 0.9995f)
+    {
+        return QuatNlerp(A, B, Time);
+    }
+
+    float Angle = acosf(CosAngle);
+    float InverseSin = 1.0f / FastSin(Angle);
+    float WeightA = FastSin((1.0f - Time) * Angle) * InverseSin;
+    float WeightB = FastSin(Time * Angle) * InverseSin * Sign;
+    T3DQuat Result;
+
+    for (int Component = 0; Component < 4; Component++)
+    {
+        Result.v[Component] = A.v[Component] * WeightA + B.v[Component] * WeightB;
+    }
+
+    return Result;
+}
+
+// Rotate a vector by a quaternion without building a matrix or calling any trig functions
+T3DVec3 QuatRotateVector(T3DQuat Quat, T3DVec3 Vector)
+{
+    T3DVec3 QuatAxis = {{Quat.v[0], Quat.v[1], Quat.v[2]}};
+    T3DVec3 Cross1;
+    T3DVec3 Cross2;
+
+    // v' = v + 2w(q x v) + 2(q x (q x v))
+    t3d_vec3_cross(&Cross1, &QuatAxis, &Vector);
+    t3d_vec3_cross(&Cross2, &QuatAxis, &Cross1);
+
+    return (T3DVec3){{
+        Vector.v[0] + 2.0f * (Quat.v[3] * Cross1.v[0] + Cross2.v[0]),
+        Vector.v[1] + 2.0f * (Quat.v[3] * Cross1.v[1] + Cross2.v[1]),
+        Vector.v[2] + 2.0f * (Quat.v[3] * Cross1.v[2] + Cross2.v[2])
+    }};
 }
 
 // ----- Range math -----
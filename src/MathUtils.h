@@ -30,6 +30,10 @@ void RotateVectorAxisX(T3DVec3* VectorToRotate, float Degrees);
 void RotateVectorAxisY(T3DVec3* VectorToRotate, float Degrees);
 void RotateVectorAxisZ(T3DVec3* VectorToRotate, float Degrees);
 void RotateVector3ByDegrees(T3DVec3* Vector3ToRotate, T3DVec3 RotationDegrees);
+void RotateVectorsAxisX(T3DVec3* Vectors, int VectorCount, float Degrees);
+void RotateVectorsAxisY(T3DVec3* Vectors, int VectorCount, float Degrees);
+void RotateVectorsAxisZ(T3DVec3* Vectors, int VectorCount, float Degrees);
+void TransformPoints(T3DVec3* Output, T3DVec3* Input, int PointCount, T3DMat4* Matrix);
 void MultiplyAxesByFloat(T3DVec3* VectorToUpdate, T3DVec3 AxesToUpdate, float MultiplyValue);
 void AddFloatToAxes(T3DVec3* VectorToUpdate, T3DVec3 AxesToUpdate, float ValueToAdd);
 void OneifyVectorZeroes(T3DVec3* VectorToUpdate);
@@ -40,7 +44,24 @@ T3DVec3 GetUpVector(T3DVec3 ForwardVector, T3DVec3 RightVector);
 
 // ----- Matrix math -----
 T3DMat4 CreateSRTMatrix(T3DVec3 Position, T3DVec3 Rotation, T3DVec3 Scale);
+void CreateSRTMatrixFP(T3DMat4FP* Matrix, T3DVec3 Position, T3DVec3 Rotation, T3DVec3 Scale);
+void CreateSRTMatrixFromQuatFP(T3DMat4FP* Matrix, T3DVec3 Position, T3DQuat Rotation, T3DVec3 Scale);
+float GetFixedMatrixElement(const T3DMat4FP* Matrix, int Column, int Row);
+T3DVec3 GetTransformWorldPosition(struct ModelTransform* Transform);
 void UpdateTransformMatrix(struct ModelTransform* Transform);
+void GetModelWorldBounds(T3DModel* Model, const T3DMat4FP* Matrix, T3DVec3* BoundsMin, T3DVec3* BoundsMax);
+void UpdateTransformBounds(struct ModelTransform* Transform, T3DModel* Model);
+
+// ----- Quaternion math -----
+T3DQuat QuatIdentity();
+T3DQuat QuatFromAxisAngle(T3DVec3 Axis, float Degrees);
+T3DQuat QuatFromEuler(T3DVec3 Rotation);
+T3DQuat QuatMultiply(T3DQuat A, T3DQuat B);
+T3DQuat QuatNormalize(T3DQuat Quat);
+float QuatDot(T3DQuat A, T3DQuat B);
+T3DQuat QuatNlerp(T3DQuat A, T3DQuat B, float Time);
+T3DQuat QuatSlerp(T3DQuat A, T3DQuat B, float Time);
+T3DVec3 QuatRotateVector(T3DQuat Quat, T3DVec3 Vector);
 
 // ----- Range math -----
 float ZeroBelowMinimum(float Number, float Minimum);
@@ -0,0 +1,462 @@
+/* N64 GAME ENGINE */
+// Memory utilities file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <malloc.h>
+#include <stdio.h>
+#include <string.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+
+
+/* VARIABLES */
+// A tracked allocation. Sequence is the number of allocations tracked before this one, which is how
+// ReportMemoryLeaks tells which allocations were made after MarkMemoryScene
+struct TrackedAllocation
+{
+    void* Pointer;
+    uint32_t Size;
+    uint32_t Sequence;
+    uint8_t Tag;
+};
+
+struct TrackedAllocation TrackedAllocations[MEMORY_TRACKER_CAPACITY];
+struct MemoryTagStats MemoryStats[MEMORY_TAG_COUNT];
+const char* MemoryTagNames[MEMORY_TAG_COUNT] = {"MODEL", "TRANSFORM", "FONT", "TEXT", "RENDER BLOCK", "SPRITE", "SCENE", "FRAME ARENA", "GAME"};
+T3DMat4FP* MatrixPoolSlab = NULL;
+uint8_t* FrameArenaSlab = NULL;
+uint32_t MatrixPoolFrames = 0;
+uint32_t MatrixPoolFrame = 0;
+uint32_t MatrixPoolMatricesPerFrame = MATRIX_POOL_DEFAULT_CAPACITY;
+uint32_t MatrixPoolCapacity = 0;
+uint32_t MatrixPoolUsed = 0;
+uint32_t MatrixPoolPeak = 0;
+uint32_t FrameArenaFrames = 0;
+uint32_t FrameArenaFrame = 0;
+uint32_t FrameArenaCapacity = 0;
+uint32_t FrameArenaUsed = 0;
+uint32_t FrameArenaPeak = 0;
+uint32_t AllocationSequence = 0;
+uint32_t MemorySceneMark = 0;
+bool EnforceMemoryBudgets = true;
+int TrackedAllocationCount = 0;
+int UntrackedAllocations = 0;
+
+
+/* FUNCTIONS */
+// ----- Matrix pool functions -----
+// Allocates one uncached slab that holds MatricesPerFrame fixed-point matrices for each frame in flight. T3D reads
+// matrices asynchronously, so each frame borrows from its own region, and a region is only handed out again once
+// the frame that used it has been displayed. InitSystem creates the pool with MatrixPoolMatricesPerFrame matrices per
+// frame, so set that before calling InitSystem to change its size. The pool can only be created once
+void InitMatrixPool(uint32_t MatricesPerFrame, uint32_t FramesInFlight)
+{
+    assertf(MatrixPoolSlab == NULL, "The matrix pool has already been initialized!");
+
+    MatrixPoolSlab = TaggedMallocUncached(sizeof(T3DMat4FP) * MatricesPerFrame * FramesInFlight, MEMORY_TAG_TRANSFORM);
+    MatrixPoolFrames = FramesInFlight;
+    MatrixPoolCapacity = MatricesPerFrame;
+    MatrixPoolFrame = 0;
+    MatrixPoolUsed = 0;
+    MatrixPoolPeak = 0;
+
+    DebugPrint("[INFO] >> Allocated matrix pool (%d matrices x %d frames, %d bytes).\n", ALL, (int)MatricesPerFrame, (int)FramesInFlight, (int)(sizeof(T3DMat4FP) * MatricesPerFrame * FramesInFlight));
+}
+
+// Move on to the next frame's region of the pool. This must only be called once the display buffer for the new
+// frame has been acquired (see StartFrame), since that guarantees the frame that last used the region is finished
+void AdvanceMatrixPool()
+{
+    MatrixPoolFrame = (MatrixPoolFrame + 1) % MatrixPoolFrames;
+    MatrixPoolPeak = MAX(MatrixPoolPeak, MatrixPoolUsed);
+    MatrixPoolUsed = 0;
+}
+
+// Borrow a single matrix for the current frame. The matrix stays valid until the frame has been drawn
+T3DMat4FP* BorrowFrameMatrix()
+{
+    return BorrowFrameMatrices(1);
+}
+
+// Borrow a contiguous block of matrices for the current frame. The matrices stay valid until the frame has been drawn
+T3DMat4FP* BorrowFrameMatrices(uint32_t MatrixCount)
+{
+    assertf(MatrixPoolSlab != NULL, "The matrix pool hasn't been initialized!");
+    assertf(MatrixPoolUsed + MatrixCount <= MatrixPoolCapacity, "The matrix pool ran out of matrices (%d / %d)!", (int)(MatrixPoolUsed + MatrixCount), (int)MatrixPoolCapacity);
+
+    T3DMat4FP* BorrowedMatrices = &MatrixPoolSlab[(MatrixPoolFrame * MatrixPoolCapacity) + MatrixPoolUsed];
+    MatrixPoolUsed += MatrixCount;
+
+    return BorrowedMatrices;
+}
+
+// ----- Frame arena functions -----
+// Allocates one slab that holds BytesPerFrame bytes for each frame in flight. Frame arena allocations are never freed
+// one by one, a frame's whole region is reused at once when that frame comes around again (see AdvanceFrameArena). This
+// keeps short lived buffers off the heap, so they can't fragment it. Calling this again will replace the current arena
+void InitFrameArena(uint32_t BytesPerFrame, uint32_t FramesInFlight)
+{
+    if (FrameArenaSlab != NULL)
+    {
+        rspq_wait();
+        TaggedFree(FrameArenaSlab);
+    }
+
+    BytesPerFrame = (BytesPerFrame + FRAME_ARENA_ALIGNMENT - 1) & ~(FRAME_ARENA_ALIGNMENT - 1);
+    FrameArenaSlab = memalign(FRAME_ARENA_ALIGNMENT, BytesPerFrame * FramesInFlight);
+    TrackAllocation(FrameArenaSlab, BytesPerFrame * FramesInFlight, MEMORY_TAG_FRAME_ARENA);
+    FrameArenaFrames = FramesInFlight;
+    FrameArenaCapacity = BytesPerFrame;
+    FrameArenaFrame = 0;
+    FrameArenaUsed = 0;
+    FrameArenaPeak = 0;
+
+    assertf(FrameArenaSlab != NULL, "Failed to allocate the frame arena (%d bytes)!", (int)(BytesPerFrame * FramesInFlight));
+    DebugPrint("[INFO] >> Allocated frame arena (%d bytes x %d frames).\n", ALL, (int)BytesPerFrame, (int)FramesInFlight);
+}
+
+// Move on to the next frame's region of the arena, which frees everything allocated in it the last time around. Like
+// AdvanceMatrixPool, this must only be called once the display buffer for the new frame has been acquired
+void AdvanceFrameArena()
+{
+    FrameArenaFrame = (FrameArenaFrame + 1) % FrameArenaFrames;
+    FrameArenaPeak = MAX(FrameArenaPeak, FrameArenaUsed);
+    FrameArenaUsed = 0;
+}
+
+// Allocate memory from the current frame's region of the arena. The memory stays valid until the frame has been drawn,
+// and must not be freed. Use TryFrameAlloc instead if running out should be handled instead of stopping the game
+void* FrameAlloc(uint32_t Size)
+{
+    uint32_t AlignedSize = (Size + FRAME_ARENA_ALIGNMENT - 1) & ~(FRAME_ARENA_ALIGNMENT - 1);
+
+    assertf(FrameArenaSlab != NULL, "The frame arena hasn't been initialized!");
+    assertf(FrameArenaUsed + AlignedSize <= FrameArenaCapacity, "The frame arena ran out of memory (%d / %d bytes)!", (int)(FrameArenaUsed + AlignedSize), (int)FrameArenaCapacity);
+
+    void* Allocation = &FrameArenaSlab[(FrameArenaFrame * FrameArenaCapacity) + FrameArenaUsed];
+    FrameArenaUsed += AlignedSize;
+
+    return Allocation;
+}
+
+// Allocate memory from the frame arena, or return NULL if this frame's part of the arena doesn't have Size bytes left
+// (after alignment). This is for callers that can fall back to something else instead of stopping the game
+void* TryFrameAlloc(uint32_t Size)
+{
+    uint32_t AlignedSize = (Size + FRAME_ARENA_ALIGNMENT - 1) & ~(FRAME_ARENA_ALIGNMENT - 1);
+
+    if (FrameArenaSlab == NULL || FrameArenaUsed + AlignedSize > FrameArenaCapacity)
+    {
+        return NULL;
+    }
+
+    return FrameAlloc(Size);
+}
+
+// Allocate memory from the frame arena that the RSP or RDP will read directly. The memory is returned through the
+// uncached segment, and its cache lines are invalidated first so stale data can't be written back over it later
+void* FrameAllocUncached(uint32_t Size)
+{
+    void* Allocation = FrameAlloc(Size);
+
+    data_cache_hit_writeback_invalidate(Allocation, (Size + FRAME_ARENA_ALIGNMENT - 1) & ~(FRAME_ARENA_ALIGNMENT - 1));
+    return UncachedAddr(Allocation);
+}
+
+// Copy a string into the frame arena
+char* FrameStrdup(const char* String)
+{
+    int StringBytes = strlen(String) + 1;
+    char* Copy = FrameAlloc(StringBytes);
+
+    memcpy(Copy, String, StringBytes);
+    return Copy;
+}
+
+// Get the number of bytes that can still be allocated from the frame arena this frame
+uint32_t GetFrameArenaBytesLeft()
+{
+    return FrameArenaCapacity - FrameArenaUsed;
+}
+
+// ----- Allocation tracking functions -----
+// Get the tracker slot a pointer would ideally be stored in
+uint32_t GetTrackerHomeSlot(void* Pointer)
+{
+    return (((uintptr_t)Pointer >> 3) * 2654435761u) & (MEMORY_TRACKER_CAPACITY - 1);
+}
+
+// Find the tracker slot a pointer is stored in, or -1 if it isn't tracked
+int FindTrackedAllocation(void* Pointer)
+{
+    for (uint32_t Slot = GetTrackerHomeSlot(Pointer); TrackedAllocations[Slot].Pointer != NULL; Slot = (Slot + 1) & (MEMORY_TRACKER_CAPACITY - 1))
+    {
+        if (TrackedAllocations[Slot].Pointer == Pointer)
+        {
+            return Slot;
+        }
+    }
+
+    return -1;
+}
+
+// Remove an allocation from the tracker's table and its tag's statistics. Later entries in the same probe chain are
+// shifted back into the hole, so lookups never need to skip over removed entries
+void RemoveTrackedAllocation(int Slot)
+{
+    struct MemoryTagStats* Stats = &MemoryStats[TrackedAllocations[Slot].Tag];
+    uint32_t Hole = Slot;
+
+    Stats->LiveBytes -= TrackedAllocations[Slot].Size;
+    Stats->LiveCount--;
+    TrackedAllocationCount--;
+
+    for (uint32_t Next = (Hole + 1) & (MEMORY_TRACKER_CAPACITY - 1); TrackedAllocations[Next].Pointer != NULL; Next = (Next + 1) & (MEMORY_TRACKER_CAPACITY - 1))
+    {
+        uint32_t Home = GetTrackerHomeSlot(TrackedAllocations[Next].Pointer);
+
+        // The entry can only be moved if the hole is between its home slot and where it is now
+        if (((Next - Home) & (MEMORY_TRACKER_CAPACITY - 1)) >= ((Next - Hole) & (MEMORY_TRACKER_CAPACITY - 1)))
+        {
+            TrackedAllocations[Hole] = TrackedAllocations[Next];
+            Hole = Next;
+        }
+    }
+
+    TrackedAllocations[Hole].Pointer = NULL;
+}
+
+// Start tracking an allocation under a tag. If the tag goes over its budget, a memory report is printed, and the game
+// is stopped if EnforceMemoryBudgets is set. If the pointer is already tracked, the old entry is replaced, since the
+// memory it described must have been freed without being untracked
+void TrackAllocation(void* Pointer, uint32_t Size, enum MemoryTags Tag)
+{
+#if ENGINE_MEMORY_TRACKING
+    if (Pointer == NULL)
+    {
+        return;
+    }
+
+    int ExistingSlot = FindTrackedAllocation(Pointer);
+
+    if (ExistingSlot != -1)
+    {
+        RemoveTrackedAllocation(ExistingSlot);
+    }
+
+    // One slot is always left empty so probing always ends
+    if (TrackedAllocationCount >= MEMORY_TRACKER_CAPACITY - 1)
+    {
+        UntrackedAllocations++;
+        return;
+    }
+
+    uint32_t Slot = GetTrackerHomeSlot(Pointer);
+
+    while (TrackedAllocations[Slot].Pointer != NULL)
+    {
+        Slot = (Slot + 1) & (MEMORY_TRACKER_CAPACITY - 1);
+    }
+
+    struct MemoryTagStats* Stats = &MemoryStats[Tag];
+
+    TrackedAllocations[Slot] = (struct TrackedAllocation){Pointer, Size, AllocationSequence++, Tag};
+    TrackedAllocationCount++;
+    Stats->LiveBytes += Size;
+    Stats->PeakBytes = MAX(Stats->PeakBytes, Stats->LiveBytes);
+    Stats->LiveCount++;
+    Stats->TotalCount++;
+
+    if (Stats->Budget > 0 && Stats->LiveBytes > Stats->Budget)
+    {
+        DebugPrint("[WARNING] >> The %s memory budget was exceeded (%d / %d bytes).\n", MINIMAL, GetMemoryTagName(Tag), (int)Stats->LiveBytes, (int)Stats->Budget);
+
+        if (EnforceMemoryBudgets == true)
+        {
+            PrintMemoryReport();
+            FlushDebugPrint();
+            assertf(Stats->LiveBytes <= Stats->Budget, "The %s memory budget was exceeded (%d / %d bytes)!", GetMemoryTagName(Tag), (int)Stats->LiveBytes, (int)Stats->Budget);
+        }
+    }
+#endif
+}
+
+// Track an allocation that was made by something the engine can't see inside of (like t3d_model_load or
+// rspq_block_end). Its size is the growth of the heap since HeapUsedBefore (from GetHeapUsedBytes)
+void TrackAllocationSince(void* Pointer, uint32_t HeapUsedBefore, enum MemoryTags Tag)
+{
+#if ENGINE_MEMORY_TRACKING
+    uint32_t HeapUsed = GetHeapUsedBytes();
+
+    TrackAllocation(Pointer, HeapUsed > HeapUsedBefore ? HeapUsed - HeapUsedBefore : 0, Tag);
+#endif
+}
+
+// Stop tracking an allocation. This should be called right before the allocation is freed. Untracked pointers are ignored
+void UntrackAllocation(void* Pointer)
+{
+#if ENGINE_MEMORY_TRACKING
+    if (Pointer == NULL)
+    {
+        return;
+    }
+
+    int Slot = FindTrackedAllocation(Pointer);
+
+    if (Slot != -1)
+    {
+        RemoveTrackedAllocation(Slot);
+    }
+#endif
+}
+
+// Allocate memory and track it under a tag
+void* TaggedMalloc(size_t Size, enum MemoryTags Tag)
+{
+    void* Pointer = malloc(Size);
+
+    TrackAllocation(Pointer, Size, Tag);
+    return Pointer;
+}
+
+// Allocate zeroed memory and track it under a tag
+void* TaggedCalloc(size_t Count, size_t Size, enum MemoryTags Tag)
+{
+    void* Pointer = calloc(Count, Size);
+
+    TrackAllocation(Pointer, Count * Size, Tag);
+    return Pointer;
+}
+
+// Allocate uncached memory and track it under a tag
+void* TaggedMallocUncached(size_t Size, enum MemoryTags Tag)
+{
+    void* Pointer = malloc_uncached(Size);
+
+    TrackAllocation(Pointer, Size, Tag);
+    return Pointer;
+}
+
+// Free memory from TaggedMalloc or TaggedCalloc
+void TaggedFree(void* Pointer)
+{
+    UntrackAllocation(Pointer);
+    free(Pointer);
+}
+
+// Free memory from TaggedMallocUncached
+void TaggedFreeUncached(void* Pointer)
+{
+    UntrackAllocation(Pointer);
+    free_uncached(Pointer);
+}
+
+// Get the number of heap bytes in use right now. This queries the heap, so it shouldn't be called every frame.
+// It works without ENGINE_MEMORY_TRACKING too, since asset sizes (and so the level streaming budget) are measured
+// with it. Only the per-tag attribution (TrackAllocationSince) is left out of those builds
+uint32_t GetHeapUsedBytes()
+{
+    heap_stats_t Stats;
+
+    sys_get_heap_stats(&Stats);
+    return Stats.used;
+}
+
+// Set the number of bytes a tag's live allocations can use (0 removes the budget)
+void SetMemoryBudget(enum MemoryTags Tag, uint32_t BudgetBytes)
+{
+    MemoryStats[Tag].Budget = BudgetBytes;
+    DebugPrint("[INFO] >> Set the %s memory budget to %d bytes.\n", ALL, GetMemoryTagName(Tag), (int)BudgetBytes);
+}
+
+// Get the name of a tag
+const char* GetMemoryTagName(enum MemoryTags Tag)
+{
+    return Tag < MEMORY_TAG_COUNT ? MemoryTagNames[Tag] : "UNKNOWN";
+}
+
+// Get the tag with the most live bytes
+enum MemoryTags GetLargestMemoryTag()
+{
+    enum MemoryTags LargestTag = 0;
+
+    for (int Tag = 1; Tag < MEMORY_TAG_COUNT; Tag++)
+    {
+        if (MemoryStats[Tag].LiveBytes > MemoryStats[LargestTag].LiveBytes)
+        {
+            LargestTag = Tag;
+        }
+    }
+
+    return LargestTag;
+}
+
+// ----- Reporting functions -----
+// Print the live bytes, peak bytes, budget and allocation counts of every tag
+void PrintMemoryReport()
+{
+    uint32_t TrackedBytes = 0;
+
+    for (int Tag = 0; Tag < MEMORY_TAG_COUNT; Tag++)
+    {
+        TrackedBytes += MemoryStats[Tag].LiveBytes;
+    }
+
+    DebugPrint("[INFO] >> Memory report (%d / %d bytes of heap used, %d tracked):\n", MINIMAL, (int)HeapStats.used, (int)HeapStats.total, (int)TrackedBytes);
+
+    for (int Tag = 0; Tag < MEMORY_TAG_COUNT; Tag++)
+    {
+        struct MemoryTagStats* Stats = &MemoryStats[Tag];
+
+        DebugPrint("    %s: %d bytes live (peak %d, budget %d), %d allocations (%d in total)\n", MINIMAL, GetMemoryTagName(Tag), (int)Stats->LiveBytes, (int)Stats->PeakBytes, (int)Stats->Budget, Stats->LiveCount, Stats->TotalCount);
+    }
+
+    if (UntrackedAllocations > 0)
+    {
+        DebugPrint("[WARNING] >> %d allocations couldn't be tracked (the tracker is full).\n", MINIMAL, UntrackedAllocations);
+    }
+}
+
+// Remember which allocations already exist, so ReportMemoryLeaks can find the ones a scene doesn't clean up. Call this
+// before loading a scene
+void MarkMemoryScene()
+{
+    MemorySceneMark = AllocationSequence;
+}
+
+// Print every tracked allocation made since the last MarkMemoryScene call that's still alive, and return how many
+// there are. Call this after tearing a scene down
+int ReportMemoryLeaks()
+{
+    int LeakCount = 0;
+    int LeakedBytes = 0;
+
+    for (int Slot = 0; Slot < MEMORY_TRACKER_CAPACITY; Slot++)
+    {
+        struct TrackedAllocation* Allocation = &TrackedAllocations[Slot];
+
+        // Subtracting keeps the comparison working once the sequence number wraps around
+        if (Allocation->Pointer != NULL && Allocation->Sequence - MemorySceneMark < AllocationSequence - MemorySceneMark)
+        {
+            char Address[16];
+
+            snprintf(Address, sizeof(Address), "%p", Allocation->Pointer);
+            DebugPrint("[WARNING] >> Leaked %d bytes (%s) at %s.\n", MINIMAL, (int)Allocation->Size, GetMemoryTagName(Allocation->Tag), Address);
+            LeakedBytes += Allocation->Size;
+            LeakCount++;
+        }
+    }
+
+    DebugPrint("[INFO] >> Found %d leaked allocations (%d bytes).\n", MINIMAL, LeakCount, LeakedBytes);
+    return LeakCount;
+}
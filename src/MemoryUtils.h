@@ -0,0 +1,104 @@
+/* N64 GAME ENGINE */
+// Memory utilities header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define MEMORYUTILS_H if it hasn't been already
+#ifndef MEMORYUTILS_H
+#define MEMORYUTILS_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define MATRIX_POOL_DEFAULT_CAPACITY 256 // The default number of matrices that can be borrowed per frame
+#define FRAME_ARENA_DEFAULT_BYTES (16 * 1024) // The default number of bytes that can be allocated from the frame arena per frame
+#define FRAME_ARENA_ALIGNMENT 16 // Every frame arena allocation is aligned to this (the size of a data cache line)
+#define MEMORY_TRACKER_CAPACITY 1024 // The number of allocations that can be tracked at once, has to be a power of 2
+
+// Track the engine's allocations per subsystem (see TrackAllocation). This costs 16 bytes per tracked allocation
+// slot, plus a heap stats query every time something opaque (like a model or font) is loaded
+#ifndef ENGINE_MEMORY_TRACKING
+#define ENGINE_MEMORY_TRACKING 1
+#endif
+
+
+/* VARIABLES */
+// The subsystems allocations are tagged with
+enum MemoryTags
+{
+    MEMORY_TAG_MODEL,
+    MEMORY_TAG_TRANSFORM,
+    MEMORY_TAG_FONT,
+    MEMORY_TAG_TEXT,
+    MEMORY_TAG_RENDER_BLOCK,
+    MEMORY_TAG_SPRITE,
+    MEMORY_TAG_SCENE,
+    MEMORY_TAG_FRAME_ARENA,
+    MEMORY_TAG_GAME,
+    MEMORY_TAG_COUNT
+};
+
+// The allocation statistics of a single tag. A budget of 0 means the tag doesn't have one
+struct MemoryTagStats
+{
+    uint32_t LiveBytes;
+    uint32_t PeakBytes;
+    uint32_t Budget;
+    int LiveCount;
+    int TotalCount;
+};
+
+extern struct MemoryTagStats MemoryStats[MEMORY_TAG_COUNT];
+extern uint32_t MatrixPoolMatricesPerFrame;
+extern uint32_t MatrixPoolCapacity;
+extern uint32_t MatrixPoolUsed;
+extern uint32_t MatrixPoolPeak;
+extern uint32_t FrameArenaCapacity;
+extern uint32_t FrameArenaUsed;
+extern uint32_t FrameArenaPeak;
+extern bool EnforceMemoryBudgets;
+extern int UntrackedAllocations;
+
+
+/* FUNCTIONS */
+// ----- Matrix pool functions -----
+void InitMatrixPool(uint32_t MatricesPerFrame, uint32_t FramesInFlight);
+void AdvanceMatrixPool();
+T3DMat4FP* BorrowFrameMatrix();
+T3DMat4FP* BorrowFrameMatrices(uint32_t MatrixCount);
+
+// ----- Frame arena functions -----
+void InitFrameArena(uint32_t BytesPerFrame, uint32_t FramesInFlight);
+void AdvanceFrameArena();
+void* FrameAlloc(uint32_t Size);
+void* TryFrameAlloc(uint32_t Size);
+void* FrameAllocUncached(uint32_t Size);
+char* FrameStrdup(const char* String);
+uint32_t GetFrameArenaBytesLeft();
+
+// ----- Allocation tracking functions -----
+void TrackAllocation(void* Pointer, uint32_t Size, enum MemoryTags Tag);
+void TrackAllocationSince(void* Pointer, uint32_t HeapUsedBefore, enum MemoryTags Tag);
+void UntrackAllocation(void* Pointer);
+void* TaggedMalloc(size_t Size, enum MemoryTags Tag);
+void* TaggedCalloc(size_t Count, size_t Size, enum MemoryTags Tag);
+void* TaggedMallocUncached(size_t Size, enum MemoryTags Tag);
+void TaggedFree(void* Pointer);
+void TaggedFreeUncached(void* Pointer);
+uint32_t GetHeapUsedBytes();
+void SetMemoryBudget(enum MemoryTags Tag, uint32_t BudgetBytes);
+const char* GetMemoryTagName(enum MemoryTags Tag);
+enum MemoryTags GetLargestMemoryTag();
+
+// ----- Reporting functions -----
+void PrintMemoryReport();
+void MarkMemoryScene();
+int ReportMemoryLeaks();
+#endif
@@ -9,6 +9,8 @@
 
 /* LIBRARIES */
 #include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "assert.h"
 #include <libdragon.h>
@@ -17,8 +19,16 @@
 #include <t3d/t3dmodel.h>
 #include <t3d/t3ddebug.h>
 #include "N64GameEngine.h"
+#include "AssetManager.h"
 #include "ColorUtils.h"
+#include "FastMath.h"
 #include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "Profiler.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include "TextUtils.h"
+#include "Trace.h"
 
 
 /* VARIABLES */
@@ -29,14 +39,19 @@ struct CameraProperties DefaultCameraProperties = {
     (T3DVec3){{0.0f, 0.0f, 0.0f}},
     (T3DVec3){{0.0f, 0.0f, 0.0f}},
     (T3DVec3){{0.0f, 1.0f, 0.0f}},
-    70.0f
+    70.0f,
+    (T3DQuat){{0.0f, 0.0f, 0.0f, 1.0f}},
+    false
 };
 
 enum EngineDebugModes CurrentDebugMode = MINIMAL;
 heap_stats_t HeapStats;
+MemoryPressureHandler MemoryPressureHook = NULL;
 surface_t* DisplaySurface = NULL;
 surface_t* DepthBuffer;
+T3DFrustum ViewFrustum;
 T3DVec3 WorldUpVector = {{0.0f, 1.0f, 0.0f}};
+T3DVec3 ViewPosition = {{0.0f, 0.0f, 0.0f}};
 long long LastHeapStatsUpdate = 0;
 float CameraClipping[2] = {10.0f, 200.0f};
 float UsedMemPercentage = 0.0f;
@@ -45,9 +60,22 @@ float DeltaTime = 0.0f;
 float TargetFPS = 60;
 float FPS = 0;
 bool DebugIsInitialized = false;
+bool BufferDebugPrint = true;
 bool ShowMemoryWarnings = true;
 bool VerifyEnoughMemory = true;
+bool EnableFrustumCulling = true;
+bool ViewFrustumIsValid = false;
+bool In2DMode = false;
+uint32_t DisplayBufferCount = 1;
+int SkippedMatrixRebuilds = 0;
+int VisibleModelCount = 0;
+int CulledModelCount = 0;
+int MatrixRebuilds = 0;
 int FrameCount = 0;
+int DebugPrintDroppedBytes = 0;
+int DebugPrintBufferUsed = 0;
+int DebugPrintUnreportedDrops = 0;
+char DebugPrintBuffer[DEBUG_PRINT_BUFFER_BYTES];
 
 
 /* FUNCTIONS */
@@ -66,6 +94,56 @@ enum EngineDebugModes GetDebugMode()
     return CurrentDebugMode;
 }
 
+// Write everything DebugPrint has buffered to the console in one go. This is called once per frame by EndFrame, and
+// whenever the buffer gets close to full. If anything had to be dropped since the last flush, a warning is written too
+void FlushDebugPrint()
+{
+    if (DebugPrintBufferUsed > 0)
+    {
+        debugf("%.*s", DebugPrintBufferUsed, DebugPrintBuffer);
+        DebugPrintBufferUsed = 0;
+    }
+
+    if (DebugPrintUnreportedDrops > 0)
+    {
+        debugf("[WARNING] >> The debug print buffer overflowed, %d bytes were dropped (%d in total).\n", DebugPrintUnreportedDrops, DebugPrintDroppedBytes);
+        DebugPrintUnreportedDrops = 0;
+    }
+}
+
+// Append a formatted piece of a message to the debug print buffer. If it doesn't fit, the buffer is flushed and the
+// piece is formatted again. Anything that still doesn't fit (a single piece bigger than the buffer) is dropped
+void DebugPrintAppend(const char* Format, ...)
+{
+    va_list ArgList;
+
+    for (int Attempt = 0; Attempt < 2; Attempt++)
+    {
+        int SpaceLeft = DEBUG_PRINT_BUFFER_BYTES - DebugPrintBufferUsed;
+
+        va_start(ArgList, Format);
+        int Length = vsnprintf(DebugPrintBuffer + DebugPrintBufferUsed, SpaceLeft, Format, ArgList);
+        va_end(ArgList);
+
+        if (Length < SpaceLeft)
+        {
+            DebugPrintBufferUsed += Length;
+            return;
+        }
+
+        // vsnprintf always leaves room for its terminator, which isn't kept in the buffer
+        if (Attempt == 1 || DebugPrintBufferUsed == 0)
+        {
+            DebugPrintBufferUsed = DEBUG_PRINT_BUFFER_BYTES - 1;
+            DebugPrintDroppedBytes += Length - (SpaceLeft - 1);
+            DebugPrintUnreportedDrops += Length - (SpaceLeft - 1);
+            return;
+        }
+
+        FlushDebugPrint();
+    }
+}
+
 // Print a formatted or unformatted message to a console. Note that this only works
 // if a console is available and debugging has been initialized. You can use the
 // following format specifiers:
@@ -77,6 +155,9 @@ enum EngineDebugModes GetDebugMode()
 //  %m -> 4x4 Matrix (T3DMat4)
 //  %C -> Color (color_t)
 //  %H -> HSV (HSVColor)
+// Messages are formatted into a buffer that's written out once per frame (or once it's
+// nearly full), since every write to the console is slow. Set BufferDebugPrint to false
+// to write every message out right away
 void DebugPrint(char* Message, enum EngineDebugModes DebugMode, ...)
 {
     if (DebugIsInitialized == false || CurrentDebugMode == NONE || (DebugMode == ALL && CurrentDebugMode == MINIMAL))
@@ -96,24 +177,24 @@ void DebugPrint(char* Message, enum EngineDebugModes DebugMode, ...)
 
                 if (*Message == 'd')
                 {
-                    debugf("%d", va_arg(ArgList, int));
+                    DebugPrintAppend("%d", va_arg(ArgList, int));
                 }
                 else if (*Message == 's')
                 {
-                    debugf("%s", va_arg(ArgList, char*));
+                    DebugPrintAppend("%s", va_arg(ArgList, char*));
                 }
                 else if (*Message == 'c')
                 {
-                    debugf("%c", va_arg(ArgList, int));
+                    DebugPrintAppend("%c", va_arg(ArgList, int));
                 }
                 else if (*Message == 'f')
                 {
-                    debugf("%f", va_arg(ArgList, double));
+                    DebugPrintAppend("%f", va_arg(ArgList, double));
                 }
                 else if (*Message == 'v')
                 {
                     T3DVec3 Vector = va_arg(ArgList, T3DVec3);
-                    debugf("{X=%f, Y=%f, Z=%f}", Vector.v[0], Vector.v[1], Vector.v[2]);
+                    DebugPrintAppend("{X=%f, Y=%f, Z=%f}", Vector.v[0], Vector.v[1], Vector.v[2]);
                 }
                 else if (*Message == 'm')
                 {
@@ -121,45 +202,50 @@ void DebugPrint(char* Message, enum EngineDebugModes DebugMode, ...)
                     
                     for (int Y = 0; Y < 4; Y++)
                     {
-                        for (int X = 0; X < 4; X++)
-                        {
-                            debugf("[%f] ", Matrix.m[Y][X]);
-                        }
-
-                        debugf("\n");
+                        DebugPrintAppend("[%f] [%f] [%f] [%f] \n", Matrix.m[Y][0], Matrix.m[Y][1], Matrix.m[Y][2], Matrix.m[Y][3]);
                     }
                 }
                 else if (*Message == 'C')
                 {
                     color_t Color = va_arg(ArgList, color_t);
-                    debugf("{R=%d, G=%d, B=%d, A=%d}", Color.r, Color.g, Color.b, Color.a);
+                    DebugPrintAppend("{R=%d, G=%d, B=%d, A=%d}", Color.r, Color.g, Color.b, Color.a);
                 }
                 else if (*Message == 'H')
                 {
                     struct HSVColor Color = va_arg(ArgList, struct HSVColor);
-                    debugf("{H=%f, S=%f, V=%f}", Color.H, Color.S, Color.V);
+                    DebugPrintAppend("{H=%f, S=%f, V=%f}", Color.H, Color.S, Color.V);
                 }
                 else if (*Message == '%')
                 {
-                    debugf("%%");
+                    DebugPrintAppend("%%");
                 }
 
                 Message++;
             }
             else
             {
-                debugf("%c", *Message);
-                Message++;
+                // Plain text is copied up to the next format specifier in one go
+                int SpanLength = strcspn(Message, "%");
+
+                DebugPrintAppend("%.*s", SpanLength, Message);
+                Message += SpanLength;
             }
         }
         
         va_end(ArgList);
+
+        if (BufferDebugPrint == false || DebugPrintBufferUsed >= DEBUG_PRINT_FLUSH_BYTES)
+        {
+            FlushDebugPrint();
+        }
     }
 }
 
 // ----- Engine functions -----
 // Stops the game and throws an error if there isn't enough memory to keep the console from crashing (>= 95% used). A warning
 // will be printed to the console if the memory usage >= 75% and if memory warnings are enabled (ShowMemoryWarnings = true).
+// If MemoryPressureHook is set (EX: by InitLevelStreamer), it's asked to free memory once the usage reaches
+// MEMORY_PRESSURE_THRESHOLD, so the game is only stopped if there's nothing left it can free
 void CheckAvailableMemory()
 {
     if (VerifyEnoughMemory == true)
@@ -169,9 +255,24 @@ void CheckAvailableMemory()
             DebugPrint("[WARNING] >> Over 75%% of memory is being used (currently at %f%%).\n", MINIMAL, UsedMemPercentage * 100.0f);
         }
 
+        if (MemoryPressureHook != NULL && UsedMemPercentage >= MEMORY_PRESSURE_THRESHOLD)
+        {
+            uint32_t BytesToFree = HeapStats.used - (uint32_t)(HeapStats.total * MEMORY_PRESSURE_TARGET);
+            uint32_t BytesFreed = MemoryPressureHook(BytesToFree);
+
+            // Released assets are normally freed a few frames later, but the heap is needed back now
+            FlushDeferredAssetFrees();
+            DebugPrint("[INFO] >> Memory pressure hook freed %d / %d bytes.\n", MINIMAL, (int)BytesFreed, (int)BytesToFree);
+            sys_get_heap_stats(&HeapStats);
+            UsedMemPercentage = (float)HeapStats.used / HeapStats.total;
+        }
+
+        // The memory report shows which subsystem grew, since the heap stats alone can't
         if (UsedMemPercentage >= 0.95f)
         {
-            assertf(UsedMemPercentage >= 0.95f, "The console ran out of memory!");
+            PrintMemoryReport();
+            FlushDebugPrint();
+            assertf(UsedMemPercentage < 0.95f, "The console ran out of memory! (%s is using the most, %d KB)", GetMemoryTagName(GetLargestMemoryTag()), (int)(MemoryStats[GetLargestMemoryTag()].LiveBytes / 1024));
         }   
     }
 }
@@ -189,6 +290,7 @@ void InitSystem(resolution_t Resolution, bitdepth_t BitDepth, uint32_t BufferNum
     DebugPrint("[== N64 Game Engine ==]\n", ALL);    
     DebugPrint("[INFO] >> Initializing display (%dx%d @ %dBPP, %d buffers)...\n", MINIMAL, Resolution.width, Resolution.height, (BitDepth + 1) * 16, BufferNum);
     display_init(Resolution, BitDepth, BufferNum, GAMMA_NONE, Filters);
+    DisplayBufferCount = BufferNum;
     SetTargetFPS(TargetFPS);
 
     DebugPrint("[INFO] >> Initializing timer...\n", ALL);
@@ -207,6 +309,17 @@ void InitSystem(resolution_t Resolution, bitdepth_t BitDepth, uint32_t BufferNum
     DebugPrint("[INFO] >> Initializing Tiny3D...\n", ALL);
     t3d_init((T3DInitParams){});
 
+    // T3D reads matrices asynchronously, so the pool keeps one region per display buffer
+    DebugPrint("[INFO] >> Initializing matrix pool...\n", ALL);
+    InitMatrixPool(MatrixPoolMatricesPerFrame, DisplayBufferCount);
+
+    // Transient per-frame allocations (like queued strings) come from the frame arena, which is split the same way
+    DebugPrint("[INFO] >> Initializing frame arena...\n", ALL);
+    InitFrameArena(FRAME_ARENA_DEFAULT_BYTES, DisplayBufferCount);
+
+    DebugPrint("[INFO] >> Initializing trace log...\n", ALL);
+    InitTrace();
+
     DebugPrint("[INFO] >> Updating heap statistics...\n", ALL);
     sys_get_heap_stats(&HeapStats);
 
@@ -216,6 +329,7 @@ void InitSystem(resolution_t Resolution, bitdepth_t BitDepth, uint32_t BufferNum
 // Update all engine data when required
 void UpdateEngine(struct CameraProperties* CamProps)
 {
+    PROFILE_BEGIN(PROFILE_ZONE_UPDATE_ENGINE);
     UpdateCameraDirections(CamProps);
 
     // Update heap statistics every x millisecond(s)
@@ -231,21 +345,43 @@ void UpdateEngine(struct CameraProperties* CamProps)
     FrameCount++;
     DeltaTime = display_get_delta_time();
     FPS = display_get_fps();
+    PROFILE_END(PROFILE_ZONE_UPDATE_ENGINE);
 }
 
 // ----- Creation functions -----
-// Creates a new render block and assigns it to a model transform
+// Get a render block that draws a model. Models acquired through the asset manager share one render block (and
+// IsShared is set, since it must not be freed), every other model gets a new one
+rspq_block_t* CreateModelRenderBlock(T3DModel* Model, bool* IsShared)
+{
+    rspq_block_t* RenderBlock = GetSharedRenderBlock(Model);
+    *IsShared = RenderBlock != NULL;
+
+    if (RenderBlock != NULL)
+    {
+        return RenderBlock;
+    }
+
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+
+    rspq_block_begin();
+    t3d_model_draw(Model);
+    RenderBlock = rspq_block_end();
+    TrackAllocationSince(RenderBlock, HeapUsedBefore, MEMORY_TAG_RENDER_BLOCK);
+    return RenderBlock;
+}
+
+// Assigns a render block to a model transform (see CreateModelRenderBlock). The transform's old block is freed if it
+// owned it
 void AssignNewRenderBlock(struct ModelTransform* Transform, T3DModel* ModelToRender)
 {
-    if (Transform->RenderBlock != NULL)
+    if (Transform->RenderBlock != NULL && Transform->SharedRenderBlock == false)
     {
         rspq_wait();
+        UntrackAllocation(Transform->RenderBlock);
         rspq_block_free(Transform->RenderBlock);
     }
 
-    rspq_block_begin();
-    t3d_model_draw(ModelToRender);
-    Transform->RenderBlock = rspq_block_end();
+    Transform->RenderBlock = CreateModelRenderBlock(ModelToRender, &Transform->SharedRenderBlock);
 }
 
 // Creates a new model transform for use with 3D rendering
@@ -253,24 +389,55 @@ struct ModelTransform CreateNewModelTransform()
 {
     struct ModelTransform NewModelTransform;
 
-    // Allocate a fixed-point matrix pointer
-    NewModelTransform.ModelMatrixFP = malloc_uncached(sizeof(T3DMat4FP));
+    // Fixed-point matrices are borrowed from the matrix pool each time the transform is drawn
+    NewModelTransform.ModelMatrixFP = NULL;
     NewModelTransform.RenderBlock = NULL;
 
     // Set SRT transform data. This will prevent undefined behavior because we initialize to a known value
     // Note that rotation (euler angles) is in degrees
     NewModelTransform.Position = (T3DVec3){{0.0f, 0.0f, 0.0f}};
     NewModelTransform.Rotation = (T3DVec3){{0.0f, 0.0f, 0.0f}};
+    NewModelTransform.RotationQuat = QuatIdentity();
+    NewModelTransform.UseQuaternion = false;
+    NewModelTransform.SharedRenderBlock = false;
     NewModelTransform.Scale = (T3DVec3){{1.0f, 1.0f, 1.0f}};
 
+    // The transform starts out dirty so the first draw builds its matrices
+    NewModelTransform.Generation = 1;
+    NewModelTransform.BuiltGeneration = 0;
+    NewModelTransform.BoundsGeneration = 0;
+    NewModelTransform.BoundsModel = NULL;
+
+#if ENGINE_FLOAT_MATRICES
     t3d_mat4_identity(&NewModelTransform.ModelMatrix);
+#endif
+
+    t3d_mat4fp_identity(&NewModelTransform.ModelMatrixFPCache);
     return NewModelTransform;
 }
 
-// Creates a new model object
+// Loads a model and tracks its memory under MEMORY_TAG_MODEL
+T3DModel* LoadModel(char* ModelPath)
+{
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+    T3DModel* Model = t3d_model_load(ModelPath);
+
+    TrackAllocationSince(Model, HeapUsedBefore, MEMORY_TAG_MODEL);
+    return Model;
+}
+
+// Frees a model loaded with LoadModel. Make sure the RSP is done drawing it first
+void FreeModel(T3DModel* Model)
+{
+    UntrackAllocation(Model);
+    t3d_model_free(Model);
+}
+
+// Creates a new model object. The model is acquired through the asset manager, so objects created from the same path
+// share one copy of the model and its render block
 void CreateNewModelObject(struct ModelObject* ModelOBJToUpdate, char* ModelPath)
 {
-    CreateNewModelObjectPredefined(ModelOBJToUpdate, t3d_model_load(ModelPath));
+    CreateNewModelObjectPredefined(ModelOBJToUpdate, AcquireModel(ModelPath));
 }
 
 // Creates a new model object
@@ -285,6 +452,255 @@ void CreateNewModelObjectPredefined(struct ModelObject* ModelOBJToUpdate, T3DMod
     }
 }
 
+// Creates a new LOD model object. Level 0 is loaded from "BaseModelPath.t3dm", and every other level x is loaded
+// from "BaseModelPath_LODx.t3dm" (EX: "rom:/Fence" loads Fence.t3dm, Fence_LOD1.t3dm, ...). See the Makefile for
+// how these files are built. Like CreateNewModelObject, the levels are acquired through the asset manager
+void CreateNewLODModelObject(struct LODModelObject* LODOBJToUpdate, char* BaseModelPath, float* SwitchDistances, int LevelCount)
+{
+    T3DModel* Models[MAX_LOD_LEVELS];
+    char ModelPath[128];
+
+    assertf(LevelCount > 0 && LevelCount <= MAX_LOD_LEVELS, "LOD level count must be between 1 and %d!", MAX_LOD_LEVELS);
+
+    for (int Level = 0; Level < LevelCount; Level++)
+    {
+        if (Level == 0)
+        {
+            snprintf(ModelPath, sizeof(ModelPath), "%s.t3dm", BaseModelPath);
+        }
+        else
+        {
+            snprintf(ModelPath, sizeof(ModelPath), "%s_LOD%d.t3dm", BaseModelPath, Level);
+        }
+
+        DebugPrint("[INFO] >> Loading LOD level %d (%s)...\n", ALL, Level, ModelPath);
+        Models[Level] = AcquireModel(ModelPath);
+    }
+
+    CreateNewLODModelObjectPredefined(LODOBJToUpdate, Models, SwitchDistances, LevelCount);
+}
+
+// Creates a new LOD model object from models that are already loaded
+void CreateNewLODModelObjectPredefined(struct LODModelObject* LODOBJToUpdate, T3DModel** Models, float* SwitchDistances, int LevelCount)
+{
+    assertf(LevelCount > 0 && LevelCount <= MAX_LOD_LEVELS, "LOD level count must be between 1 and %d!", MAX_LOD_LEVELS);
+
+    LODOBJToUpdate->Transform = CreateNewModelTransform();
+    LODOBJToUpdate->LevelCount = LevelCount;
+    LODOBJToUpdate->CurrentLevel = 0;
+    LODOBJToUpdate->Hysteresis = 5.0f;
+
+    // Each level can be a managed model or not, so whether its render block is shared is tracked per level
+    for (int Level = 0; Level < LevelCount; Level++)
+    {
+        LODOBJToUpdate->Models[Level] = Models[Level];
+        LODOBJToUpdate->Transform.RenderBlock = NULL;
+        AssignNewRenderBlock(&LODOBJToUpdate->Transform, Models[Level]);
+        LODOBJToUpdate->RenderBlocks[Level] = LODOBJToUpdate->Transform.RenderBlock;
+        LODOBJToUpdate->SharedRenderBlocks[Level] = LODOBJToUpdate->Transform.SharedRenderBlock;
+
+        if (Level < LevelCount - 1)
+        {
+            LODOBJToUpdate->SwitchDistances[Level] = SwitchDistances[Level];
+        }
+    }
+
+    LODOBJToUpdate->Transform.RenderBlock = LODOBJToUpdate->RenderBlocks[0];
+    LODOBJToUpdate->Transform.SharedRenderBlock = LODOBJToUpdate->SharedRenderBlocks[0];
+}
+
+// Frees the render blocks a LOD model object owns, and releases its models that were acquired through the asset
+// manager (like the ones CreateNewLODModelObject loads). Models that aren't managed are left to the caller
+void FreeLODModelObject(struct LODModelObject* LODOBJ)
+{
+    rspq_wait();
+
+    for (int Level = 0; Level < LODOBJ->LevelCount; Level++)
+    {
+        if (LODOBJ->SharedRenderBlocks[Level] == false)
+        {
+            UntrackAllocation(LODOBJ->RenderBlocks[Level]);
+            rspq_block_free(LODOBJ->RenderBlocks[Level]);
+        }
+
+        if (IsManagedAsset(LODOBJ->Models[Level]) == true)
+        {
+            ReleaseAsset(LODOBJ->Models[Level]);
+        }
+
+        LODOBJ->RenderBlocks[Level] = NULL;
+        LODOBJ->Models[Level] = NULL;
+    }
+
+    LODOBJ->Transform.RenderBlock = NULL;
+    LODOBJ->LevelCount = 0;
+}
+
+// Bakes a set of model objects that never move into a single render block. The objects' current transforms are
+// written into one uncached matrix array owned by the batch, and the block records every push / draw / pop, so the
+// whole batch is drawn with one rspq_block_run. Moving the objects afterwards has no effect on the batch
+void CreateStaticBatch(struct StaticBatch* Batch, struct ModelObject** Objects, int ObjectCount)
+{
+    assertf(ObjectCount > 0, "A static batch needs at least one object!");
+
+    Batch->Matrices = TaggedMallocUncached(sizeof(T3DMat4FP) * ObjectCount, MEMORY_TAG_TRANSFORM);
+    Batch->ObjectCount = ObjectCount;
+
+    for (int ObjectIndex = 0; ObjectIndex < ObjectCount; ObjectIndex++)
+    {
+        struct ModelTransform* Transform = &Objects[ObjectIndex]->Transform;
+
+        UpdateTransformMatrix(Transform);
+        UpdateTransformBounds(Transform, Objects[ObjectIndex]->Model);
+        Batch->Matrices[ObjectIndex] = Transform->ModelMatrixFPCache;
+
+        for (int Axis = 0; Axis < 3; Axis++)
+        {
+            Batch->BoundsMin.v[Axis] = ObjectIndex == 0 ? Transform->BoundsMin.v[Axis] : MIN(Batch->BoundsMin.v[Axis], Transform->BoundsMin.v[Axis]);
+            Batch->BoundsMax.v[Axis] = ObjectIndex == 0 ? Transform->BoundsMax.v[Axis] : MAX(Batch->BoundsMax.v[Axis], Transform->BoundsMax.v[Axis]);
+        }
+    }
+
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+
+    rspq_block_begin();
+
+    for (int ObjectIndex = 0; ObjectIndex < ObjectCount; ObjectIndex++)
+    {
+        t3d_matrix_push(&Batch->Matrices[ObjectIndex]);
+        t3d_model_draw(Objects[ObjectIndex]->Model);
+        t3d_matrix_pop(1);
+    }
+
+    Batch->RenderBlock = rspq_block_end();
+    TrackAllocationSince(Batch->RenderBlock, HeapUsedBefore, MEMORY_TAG_RENDER_BLOCK);
+    DebugPrint("[INFO] >> Baked %d static objects into one render block.\n", ALL, ObjectCount);
+}
+
+// Frees a static batch's render block and matrices
+void FreeStaticBatch(struct StaticBatch* Batch)
+{
+    rspq_wait();
+    UntrackAllocation(Batch->RenderBlock);
+    rspq_block_free(Batch->RenderBlock);
+    TaggedFreeUncached(Batch->Matrices);
+
+    Batch->RenderBlock = NULL;
+    Batch->Matrices = NULL;
+    Batch->ObjectCount = 0;
+}
+
+// Records the render blocks an instance batch draws its instances with. The model is recorded once, and level x's
+// block sets 2^x matrices from INSTANCE_MATRIX_SEGMENT (each followed by a run of the model's block), so the blocks
+// only depend on where the segment points and never have to be recorded again
+void CreateInstanceBatch(struct InstanceBatch* Batch, T3DModel* Model, int MaxInstances)
+{
+    assertf(MaxInstances > 0 && MaxInstances < (1 << INSTANCE_BATCH_MAX_LEVELS), "Instance batches can draw between 1 and %d instances!", (1 << INSTANCE_BATCH_MAX_LEVELS) - 1);
+
+    T3DMat4FP* SegmentMatrices = t3d_segment_placeholder(INSTANCE_MATRIX_SEGMENT);
+    uint32_t HeapUsedBefore = GetHeapUsedBytes();
+
+    Batch->Model = Model;
+    Batch->MaxInstances = MaxInstances;
+    Batch->LevelCount = 0;
+
+    rspq_block_begin();
+    t3d_model_draw(Model);
+    Batch->ModelBlock = rspq_block_end();
+    TrackAllocationSince(Batch->ModelBlock, HeapUsedBefore, MEMORY_TAG_RENDER_BLOCK);
+
+    // Enough levels are recorded for their sizes to add up to MaxInstances
+    while ((1 << Batch->LevelCount) - 1 < MaxInstances)
+    {
+        int LevelInstances = 1 << Batch->LevelCount;
+
+        HeapUsedBefore = GetHeapUsedBytes();
+        rspq_block_begin();
+
+        for (int InstanceIndex = 0; InstanceIndex < LevelInstances; InstanceIndex++)
+        {
+            t3d_matrix_set(SegmentMatrices + InstanceIndex, true);
+            rspq_block_run(Batch->ModelBlock);
+        }
+
+        Batch->RenderBlocks[Batch->LevelCount] = rspq_block_end();
+        TrackAllocationSince(Batch->RenderBlocks[Batch->LevelCount], HeapUsedBefore, MEMORY_TAG_RENDER_BLOCK);
+        Batch->LevelCount++;
+    }
+
+    DebugPrint("[INFO] >> Recorded %d instance blocks for up to %d instances.\n", ALL, Batch->LevelCount, MaxInstances);
+}
+
+// Frees an instance batch's render blocks. The model isn't freed
+void FreeInstanceBatch(struct InstanceBatch* Batch)
+{
+    rspq_wait();
+
+    for (int Level = 0; Level < Batch->LevelCount; Level++)
+    {
+        UntrackAllocation(Batch->RenderBlocks[Level]);
+        rspq_block_free(Batch->RenderBlocks[Level]);
+        Batch->RenderBlocks[Level] = NULL;
+    }
+
+    UntrackAllocation(Batch->ModelBlock);
+    rspq_block_free(Batch->ModelBlock);
+
+    Batch->ModelBlock = NULL;
+    Batch->LevelCount = 0;
+    Batch->MaxInstances = 0;
+}
+
+// ----- Transform functions -----
+// Set a transform's position and mark its matrices for rebuilding
+void SetTransformPosition(struct ModelTransform* Transform, T3DVec3 Position)
+{
+    Transform->Position = Position;
+    Transform->Generation++;
+}
+
+// Set a transform's rotation (euler angles, in degrees) and mark its matrices for rebuilding
+void SetTransformRotation(struct ModelTransform* Transform, T3DVec3 Rotation)
+{
+    Transform->Rotation = Rotation;
+    Transform->UseQuaternion = false;
+    Transform->Generation++;
+}
+
+// Set a transform's rotation as a quaternion and mark its matrices for rebuilding. The transform keeps using the
+// quaternion until SetTransformRotation is called
+void SetTransformRotationQuat(struct ModelTransform* Transform, T3DQuat Rotation)
+{
+    Transform->RotationQuat = Rotation;
+    Transform->UseQuaternion = true;
+    Transform->Generation++;
+}
+
+// Rotate a transform by a quaternion (relative to its current rotation) and mark its matrices for rebuilding.
+// If the transform was using euler angles, they're converted to a quaternion first
+void RotateTransformByQuat(struct ModelTransform* Transform, T3DQuat Rotation)
+{
+    if (Transform->UseQuaternion == false)
+    {
+        Transform->RotationQuat = QuatFromEuler(Transform->Rotation);
+    }
+
+    SetTransformRotationQuat(Transform, QuatNormalize(QuatMultiply(Transform->RotationQuat, Rotation)));
+}
+
+// Set a transform's scale and mark its matrices for rebuilding
+void SetTransformScale(struct ModelTransform* Transform, T3DVec3 Scale)
+{
+    Transform->Scale = Scale;
+    Transform->Generation++;
+}
+
+// Mark a transform's matrices for rebuilding. This must be called after writing to Position, Rotation or Scale directly
+void MarkTransformDirty(struct ModelTransform* Transform)
+{
+    Transform->Generation++;
+}
+
 // ----- Timing functions -----
 // Returns the console's uptime in milliseconds (converts uptime in microseconds to milliseconds)
 long long UptimeMilliseconds()
@@ -320,14 +736,45 @@ void RotateCameraToAngle(float XAngle, float YAngle, struct CameraProperties* Ca
     CamProps->Target.v[2] = UnitSpherePoint.v[2];
 }
 
-// Rotate the camera by x degrees (relative to its current angles)
+// Rotate the camera by x degrees (relative to its current angles). Quaternion cameras yaw around the world up
+// vector and pitch / roll around their own axes. Axes that aren't rotated are skipped, so a stick that's only moved
+// along one axis costs a single sin / cos, and the orientation is only normalized and applied once
 void RotateCameraRelative(float XAngle, float YAngle, float ZAngle, struct CameraProperties* CamProps)
 {
+    if (CamProps->UseQuaternion == true)
+    {
+        T3DQuat NewOrientation = CamProps->Orientation;
+
+        if (XAngle != 0.0f)
+        {
+            NewOrientation = QuatMultiply(QuatFromAxisAngle(WorldUpVector, -XAngle), NewOrientation);
+        }
+
+        if (YAngle != 0.0f)
+        {
+            NewOrientation = QuatMultiply(NewOrientation, QuatFromAxisAngle((T3DVec3){{1.0f, 0.0f, 0.0f}}, YAngle));
+        }
+
+        if (ZAngle != 0.0f)
+        {
+            NewOrientation = QuatMultiply(NewOrientation, QuatFromAxisAngle((T3DVec3){{0.0f, 0.0f, -1.0f}}, ZAngle));
+        }
+
+        if (XAngle != 0.0f || YAngle != 0.0f || ZAngle != 0.0f)
+        {
+            SetCameraOrientation(CamProps, QuatNormalize(NewOrientation));
+        }
+
+        return;
+    }
+
     T3DVec3 TargetRotation = (T3DVec3){{0.0f, 0.0f, 0.0f}};
     float USRadius = t3d_vec3_distance(&CamProps->Position, &CamProps->Target);
-    float XRadians = T3D_DEG_TO_RAD(XAngle);
-    float YRadians = T3D_DEG_TO_RAD(YAngle);
     float ZRadians = T3D_DEG_TO_RAD(ZAngle);
+    float XSin, XCos, YSin, YCos;
+
+    FastSinCosDeg(XAngle, &XSin, &XCos);
+    FastSinCosDeg(YAngle, &YSin, &YCos);
 
     // Calculate the direction from the camera to the target
     TargetRotation.v[0] = CamProps->Target.v[0] - CamProps->Position.v[0];
@@ -335,26 +782,57 @@ void RotateCameraRelative(float XAngle, float YAngle, float ZAngle, struct Camer
     t3d_vec3_norm(&TargetRotation);
 
     // Left / Right rotation
-    CamProps->Target.v[0] = CamProps->Position.v[0] + (TargetRotation.v[0] * cos(XRadians) - TargetRotation.v[2] * sin(XRadians));
-    CamProps->Target.v[2] = CamProps->Position.v[2] + (TargetRotation.v[0] * sin(XRadians) + TargetRotation.v[2] * cos(XRadians));
+    CamProps->Target.v[0] = CamProps->Position.v[0] + (TargetRotation.v[0] * XCos - TargetRotation.v[2] * XSin);
+    CamProps->Target.v[2] = CamProps->Position.v[2] + (TargetRotation.v[0] * XSin + TargetRotation.v[2] * XCos);
     CamProps->UpDir.v[2] = ZRadians;
 
     // Up / Down rotation
-    CamProps->Target.v[1] += sin(YRadians) * USRadius;
+    CamProps->Target.v[1] += YSin * USRadius;
 }
 
 // Rotate the camera by x degrees around a 3D point
 void RotateCameraAroundPoint(float RotationAngle, struct CameraProperties* CamProps, T3DVec3 PointToRotateAround)
 {
-    float Radians = T3D_DEG_TO_RAD(RotationAngle);
-    float DX = CamProps->Position.v[0] * cos(Radians) - CamProps->Position.v[2] * sin(Radians);
-    float DZ = CamProps->Position.v[0] * sin(Radians) + CamProps->Position.v[2] * cos(Radians);
+    float Sin, Cos;
+    FastSinCosDeg(RotationAngle, &Sin, &Cos);
+
+    float DX = CamProps->Position.v[0] * Cos - CamProps->Position.v[2] * Sin;
+    float DZ = CamProps->Position.v[0] * Sin + CamProps->Position.v[2] * Cos;
 
     CamProps->Position.v[0] = PointToRotateAround.v[0] + DX;
     CamProps->Position.v[2] = PointToRotateAround.v[2] + DZ;
     CamProps->Target.v[1] = PointToRotateAround.v[1];
 }
 
+// Set a quaternion camera's orientation, and point its target and up direction to match. The target keeps its
+// distance from the camera
+void SetCameraOrientation(struct CameraProperties* CamProps, T3DQuat Orientation)
+{
+    float TargetDistance = t3d_vec3_distance(&CamProps->Position, &CamProps->Target);
+    T3DVec3 Forward = QuatRotateVector(Orientation, (T3DVec3){{0.0f, 0.0f, -1.0f}});
+
+    if (TargetDistance <= 0.0f)
+    {
+        TargetDistance = 1.0f;
+    }
+
+    CamProps->Orientation = Orientation;
+    CamProps->UseQuaternion = true;
+    CamProps->UpDir = QuatRotateVector(Orientation, WorldUpVector);
+    CamProps->Target.v[0] = CamProps->Position.v[0] + Forward.v[0] * TargetDistance;
+    CamProps->Target.v[1] = CamProps->Position.v[1] + Forward.v[1] * TargetDistance;
+    CamProps->Target.v[2] = CamProps->Position.v[2] + Forward.v[2] * TargetDistance;
+}
+
+// Rotate a quaternion camera by a quaternion, either around its own axes (LocalSpace) or around the world axes.
+// A rotation that's applied every frame only needs to be converted to a quaternion once, after that no trig is needed
+void RotateCameraByQuat(struct CameraProperties* CamProps, T3DQuat Rotation, bool LocalSpace)
+{
+    T3DQuat NewOrientation = LocalSpace ? QuatMultiply(CamProps->Orientation, Rotation) : QuatMultiply(Rotation, CamProps->Orientation);
+
+    SetCameraOrientation(CamProps, QuatNormalize(NewOrientation));
+}
+
 // Moves the camera up and down along its local or world up vector
 void MoveCameraVertical(struct CameraProperties* CamProps, float DistanceStep, bool UseWorldUp)
 {
@@ -409,46 +887,247 @@ void MoveCameraToPoint(struct CameraProperties* CamProps, T3DVec3)
 }
 
 // ----- Drawing functions -----
-// Draws a string on the screen at the specified X & Y coords, and font
+// Draws a string on the screen at the specified X & Y coords, and font. If the render queue is enabled, the string
+// is queued and drawn (grouped by font) when the frame ends
 void DrawString(char* Text, int FontID, int XPos, int YPos)
 {
-    int StrLength = strlen(Text);
-    rdpq_paragraph_t* par = rdpq_paragraph_build(&(rdpq_textparms_t){
-        .valign = VALIGN_TOP,
-        .align = ALIGN_LEFT,
-        .width = 320,
-        .height = 240,
-        .wrap = WRAP_WORD,
-    }, FontID, Text, &StrLength);
+    DrawStringStyled(Text, FontID, 0, XPos, YPos);
+}
+
+// Draws a string on the screen with one of its font's styles (see rdpq_font_style). Styles are looked up when the
+// string is rendered, so changing a style's color doesn't make its strings' cached layouts go stale
+void DrawStringStyled(char* Text, int FontID, int StyleID, int XPos, int YPos)
+{
+    if (UseRenderQueue == true)
+    {
+        QueueString(Text, FontID, StyleID, XPos, YPos);
+        return;
+    }
+
+    DrawStringImmediate(Text, FontID, StyleID, XPos, YPos);
+}
+
+// Draws a string on the screen right away, even if the render queue is enabled. The string is laid out with
+// TextDrawParams, and its layout is cached, so drawing the same text again only costs the render
+void DrawStringImmediate(char* Text, int FontID, int StyleID, int XPos, int YPos)
+{
+    PROFILE_BEGIN(PROFILE_ZONE_TEXT);
+
+    rdpq_textparms_t Params = TextDrawParams;
+
+    Params.style_id = StyleID;
+    rdpq_paragraph_t* par = GetCachedParagraph(Text, FontID, &Params);
 
     rdpq_paragraph_render(par, XPos, YPos);
-    rdpq_paragraph_free(par);
+    PROFILE_END(PROFILE_ZONE_TEXT);
 }
 
 // Render a 3D model
-void RenderModel(struct ModelObject ModelOBJ, bool UpdateMatrix)
+void RenderModel(struct ModelObject* ModelOBJ, bool UpdateMatrix)
 {
-    RenderModelWithTransform(ModelOBJ.Model, &ModelOBJ.Transform, UpdateMatrix);
+    RenderModelWithTransform(ModelOBJ->Model, &ModelOBJ->Transform, UpdateMatrix);
 }
 
 // Render a 3D model with the specified SRT
 void RenderModelWithTransform(T3DModel* ModelToRender, struct ModelTransform* Transform, bool UpdateMatrix)
 {
+    PROFILE_BEGIN(PROFILE_ZONE_RENDER_MODEL);
+
     if (UpdateMatrix == true)
     {
         UpdateTransformMatrix(Transform);
     }
 
+    // Skip the model entirely if it's fully outside of the view frustum
+    if (IsModelVisible(ModelToRender, Transform) == false)
+    {
+        CulledModelCount++;
+        PROFILE_END(PROFILE_ZONE_RENDER_MODEL);
+        return;
+    }
+
+    RenderModelUnculled(ModelToRender, Transform);
+    PROFILE_END(PROFILE_ZONE_RENDER_MODEL);
+}
+
+// Render a 3D model with the specified SRT, without rebuilding its matrix or checking if it's inside of the view
+// frustum. This is for callers that already know the model is visible (like RenderSpatialGridVisible)
+void RenderModelUnculled(T3DModel* ModelToRender, struct ModelTransform* Transform)
+{
     if (Transform->RenderBlock == NULL)
     {
         AssignNewRenderBlock(Transform, ModelToRender);
     }
 
-    // Render the model
+    Transform->ModelMatrixFP = RenderModelMatrix(ModelToRender, Transform->RenderBlock, &Transform->ModelMatrixFPCache);
+}
+
+// Render a model's render block with a fixed-point matrix (or queue it, if the render queue is enabled), without any
+// culling. Every draw borrows its own copy of the matrix, so the same matrix can safely be drawn more than once per
+// frame. Returns the borrowed copy
+T3DMat4FP* RenderModelMatrix(T3DModel* ModelToRender, rspq_block_t* RenderBlock, const T3DMat4FP* Matrix)
+{
+    T3DMat4FP* FrameMatrix = BorrowFrameMatrix();
+
+    *FrameMatrix = *Matrix;
+    VisibleModelCount++;
+
+    if (UseRenderQueue == true)
+    {
+        T3DVec3 WorldPosition = {{GetFixedMatrixElement(Matrix, 3, 0), GetFixedMatrixElement(Matrix, 3, 1), GetFixedMatrixElement(Matrix, 3, 2)}};
+
+        QueueModel(ModelToRender, FrameMatrix, t3d_vec3_distance2(&ViewPosition, &WorldPosition));
+        return FrameMatrix;
+    }
+
     t3d_matrix_push_pos(1);
-    t3d_matrix_set(Transform->ModelMatrixFP, true);
-    rspq_block_run(Transform->RenderBlock);
+    t3d_matrix_set(FrameMatrix, true);
+    rspq_block_run(RenderBlock);
     t3d_matrix_pop(1);
+    return FrameMatrix;
+}
+
+// Render a LOD model, picking the level from the distance between the camera (as of the last UpdateViewport call) and
+// the object's world position (the translation of its built matrix, so parented objects work too). The level only
+// changes once the camera is more than Hysteresis units past a switch distance, which stops objects sitting right at
+// a switch distance from flickering between levels
+void RenderLODModel(struct LODModelObject* LODOBJ, bool UpdateMatrix)
+{
+    if (UpdateMatrix == true)
+    {
+        UpdateTransformMatrix(&LODOBJ->Transform);
+    }
+
+    T3DVec3 WorldPosition = GetTransformWorldPosition(&LODOBJ->Transform);
+    float Distance = t3d_vec3_distance(&ViewPosition, &WorldPosition);
+
+    while (LODOBJ->CurrentLevel < LODOBJ->LevelCount - 1 && Distance > LODOBJ->SwitchDistances[LODOBJ->CurrentLevel] + LODOBJ->Hysteresis)
+    {
+        LODOBJ->CurrentLevel++;
+    }
+
+    while (LODOBJ->CurrentLevel > 0 && Distance < LODOBJ->SwitchDistances[LODOBJ->CurrentLevel - 1] - LODOBJ->Hysteresis)
+    {
+        LODOBJ->CurrentLevel--;
+    }
+
+    LODOBJ->Transform.RenderBlock = LODOBJ->RenderBlocks[LODOBJ->CurrentLevel];
+    LODOBJ->Transform.SharedRenderBlock = LODOBJ->SharedRenderBlocks[LODOBJ->CurrentLevel];
+    RenderModelWithTransform(LODOBJ->Models[LODOBJ->CurrentLevel], &LODOBJ->Transform, false);
+}
+
+// Render a static batch. The batch is culled as a whole, using the bounding box around all of its objects
+void RenderStaticBatch(struct StaticBatch* Batch)
+{
+    if (EnableFrustumCulling == true && ViewFrustumIsValid == true && t3d_frustum_vs_aabb(&ViewFrustum, &Batch->BoundsMin, &Batch->BoundsMax) == false)
+    {
+        CulledModelCount += Batch->ObjectCount;
+        return;
+    }
+
+    VisibleModelCount += Batch->ObjectCount;
+    rspq_block_run(Batch->RenderBlock);
+}
+
+// Render many copies of the same 3D model, one per transform. The visible instances' matrices are packed into one
+// contiguous block borrowed from the matrix pool, and the batch's prerecorded blocks walk that array through
+// INSTANCE_MATRIX_SEGMENT. The CPU only submits one segment set and one block run per set bit of the visible count
+// (EX: 512 visible instances are one of each), instead of a matrix set and a block run per instance
+void RenderModelInstances(struct InstanceBatch* Batch, struct ModelTransform* Transforms, int InstanceCount, bool UpdateMatrices)
+{
+    assertf(InstanceCount <= Batch->MaxInstances, "Instance batch can only draw %d instances (%d requested)!", Batch->MaxInstances, InstanceCount);
+
+    if (InstanceCount <= 0)
+    {
+        return;
+    }
+
+    T3DMat4FP* InstanceMatrices = BorrowFrameMatrices(InstanceCount);
+    int VisibleInstances = 0;
+
+    // Only the instances inside of the view frustum are packed into the matrix block
+    for (int InstanceIndex = 0; InstanceIndex < InstanceCount; InstanceIndex++)
+    {
+        struct ModelTransform* Transform = &Transforms[InstanceIndex];
+
+        if (UpdateMatrices == true)
+        {
+            UpdateTransformMatrix(Transform);
+        }
+
+        if (IsModelVisible(Batch->Model, Transform) == false)
+        {
+            CulledModelCount++;
+            continue;
+        }
+
+        Transform->ModelMatrixFP = &InstanceMatrices[VisibleInstances];
+        *Transform->ModelMatrixFP = Transform->ModelMatrixFPCache;
+        VisibleInstances++;
+
+        // Queued instances are sorted like any other model, so they end up next to each other anyway
+        if (UseRenderQueue == true)
+        {
+            QueueModel(Batch->Model, Transform->ModelMatrixFP, GetTransformViewDepth(Transform));
+        }
+    }
+
+    VisibleModelCount += VisibleInstances;
+
+    if (VisibleInstances == 0 || UseRenderQueue == true)
+    {
+        return;
+    }
+
+    int DrawnInstances = 0;
+
+    t3d_matrix_push_pos(1);
+
+    // The biggest blocks go first, each one starting where the previous one stopped in the matrix block
+    for (int Level = Batch->LevelCount - 1; Level >= 0; Level--)
+    {
+        if ((VisibleInstances & (1 << Level)) != 0)
+        {
+            t3d_segment_set(INSTANCE_MATRIX_SEGMENT, &InstanceMatrices[DrawnInstances]);
+            rspq_block_run(Batch->RenderBlocks[Level]);
+            DrawnInstances += 1 << Level;
+        }
+    }
+
+    t3d_matrix_pop(1);
+}
+
+// Get the squared distance between the camera and a transform's world position, used for depth sorting
+float GetTransformViewDepth(struct ModelTransform* Transform)
+{
+    T3DVec3 WorldPosition = GetTransformWorldPosition(Transform);
+
+    return t3d_vec3_distance2(&ViewPosition, &WorldPosition);
+}
+
+// Check if any part of a model's world space bounding box is inside of the view frustum. This always returns
+// true if frustum culling is disabled or if the viewport hasn't been updated yet
+bool IsModelVisible(T3DModel* Model, struct ModelTransform* Transform)
+{
+    if (EnableFrustumCulling == false || ViewFrustumIsValid == false)
+    {
+        return true;
+    }
+
+    UpdateTransformBounds(Transform, Model);
+    return t3d_frustum_vs_aabb(&ViewFrustum, &Transform->BoundsMin, &Transform->BoundsMax);
+}
+
+// Check if any part of a world space bounding box is inside of the view frustum. Like IsModelVisible, this always
+// returns true if frustum culling is disabled or if the viewport hasn't been updated yet
+bool IsBoundsVisible(T3DVec3* BoundsMin, T3DVec3* BoundsMax)
+{
+    if (EnableFrustumCulling == false || ViewFrustumIsValid == false)
+    {
+        return true;
+    }
+
+    return t3d_frustum_vs_aabb(&ViewFrustum, BoundsMin, BoundsMax);
 }
 
 // Clear the screen and adjust lighting information
@@ -471,11 +1150,22 @@ void UpdateViewport(T3DViewport* Viewport, struct CameraProperties CamProps)
 {
     t3d_viewport_set_projection(Viewport, T3D_DEG_TO_RAD(CamProps.FOV), CameraClipping[0], CameraClipping[1]);
     t3d_viewport_look_at(Viewport, &CamProps.Position, &CamProps.Target, &CamProps.UpDir);
+    ViewPosition = CamProps.Position;
+
+    // Extract the 6 world space frustum planes from the combined projection and camera matrices, for culling
+    T3DMat4 CamProjMatrix;
+    t3d_mat4_mul(&CamProjMatrix, &Viewport->matProj, &Viewport->matCamera);
+    t3d_mat4_to_frustum(&ViewFrustum, &CamProjMatrix);
+    ViewFrustumIsValid = true;
 }
 
-// Begin a frame
+// Begin a frame. This also starts a new profiler frame, so StartFrame's own zone includes the time display_get spends
+// waiting for a free buffer
 void StartFrame()
 {
+    NextProfilerFrame();
+    PROFILE_BEGIN(PROFILE_ZONE_START_FRAME);
+
     if (!DisplaySurface)
     {        
         DepthBuffer = display_get_zbuf();
@@ -483,26 +1173,73 @@ void StartFrame()
 
     DisplaySurface = display_get();
 
+    // display_get only returns once the frame that last used this buffer is done, so its matrices and frame arena
+    // allocations can be reused, and assets released back then can be freed
+    AdvanceMatrixPool();
+    AdvanceFrameArena();
+    UpdateDeferredAssetFrees();
+    SkippedMatrixRebuilds = 0;
+    MatrixRebuilds = 0;
+    VisibleModelCount = 0;
+    CulledModelCount = 0;
+    RenderQueueStateChangesSaved = 0;
+    TextCacheHits = 0;
+    TextCacheMisses = 0;
+    SpriteBatchUploads = 0;
+    SpriteBatchDraws = 0;
+
     rdpq_attach(DisplaySurface, DepthBuffer);
+    PROFILE_END(PROFILE_ZONE_START_FRAME);
 }
 
-// Finish a frame
+// Finish a frame. Anything still in the render queue or the sprite batch is drawn first
 void EndFrame(struct CameraProperties* CamProps)
 {
+    PROFILE_BEGIN(PROFILE_ZONE_END_FRAME);
+
+    if ((IsRenderQueue2DEmpty() == false || IsSpriteBatchEmpty() == false) && In2DMode == false)
+    {
+        Start2DMode();
+    }
+
+    FlushRenderQueue3D();
+    FlushSpriteBatch();
+    FlushRenderQueue2D();
     rdpq_detach_show();
     UpdateEngine(CamProps);
+
+    // The RDP is busy drawing the frame now, so this is where async loads get their slice
+    UpdateAssetLoads();
+    TRACE_ALL("Frame %d: %d visible, %d culled, %d matrix rebuilds, %.2f FPS\n", FrameCount, VisibleModelCount, CulledModelCount, MatrixRebuilds, FPS);
+    FlushDebugPrint();
+
+    if (TraceAutoFlush == true)
+    {
+        FlushTrace();
+    }
+
+    PROFILE_END(PROFILE_ZONE_END_FRAME);
 }
 
 // Configure RDPQ for 3D
 void Start3DMode(T3DViewport* Viewport)
 {
+    // Sprites queued in 2D mode have to be drawn before the RDP is set up for 3D again
+    if (In2DMode == true)
+    {
+        FlushSpriteBatch();
+    }
+
+    In2DMode = false;
     t3d_frame_start();
     t3d_viewport_attach(Viewport);
 }
 
-// Configure RDPQ for 2D
+// Configure RDPQ for 2D. Queued models have to be drawn before this, so the 3D part of the render queue is flushed
 void Start2DMode()
 {
+    FlushRenderQueue3D();
+    In2DMode = true;
     rdpq_sync_pipe();
     rdpq_set_mode_standard();
 }
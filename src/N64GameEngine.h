@@ -18,6 +18,19 @@
 
 /* DEFINITIONS */
 #define HEAPSTATS_UPDATE_MS 100
+#define MAX_LOD_LEVELS 4
+#define INSTANCE_BATCH_MAX_LEVELS 12 // An instance batch can draw up to 2^x - 1 instances at once
+#define INSTANCE_MATRIX_SEGMENT 1 // The Tiny3D segment instance batches read their matrix arrays through
+#define DEBUG_PRINT_BUFFER_BYTES 4096 // The size of the buffer DebugPrint formats into before it's written out
+#define DEBUG_PRINT_FLUSH_BYTES 3072 // The buffer is written out early once it holds this many bytes
+#define MEMORY_PRESSURE_THRESHOLD 0.85f // The fraction of the heap in use that makes CheckAvailableMemory call MemoryPressureHook
+#define MEMORY_PRESSURE_TARGET 0.70f // The fraction of the heap MemoryPressureHook is asked to get back under
+
+// Keep a float copy of every transform's matrix (ModelTransform.ModelMatrix). This costs 64 bytes per transform
+// and a second pass over the matrix on every rebuild, and the engine only needs the fixed-point matrix
+#ifndef ENGINE_FLOAT_MATRICES
+#define ENGINE_FLOAT_MATRICES 0
+#endif
 
 
 /* VARIABLES */
@@ -32,7 +45,14 @@ enum EngineDebugModes
     MINIMAL
 };
 
+// Called by CheckAvailableMemory when the heap is running low (see MEMORY_PRESSURE_THRESHOLD). It should free up to
+// BytesToFree bytes of memory that can be loaded again later, and return the number of bytes it freed
+typedef uint32_t (*MemoryPressureHandler)(uint32_t BytesToFree);
+
 // Stores the camera's position, target (3D point to look at), it's up direction, and the FOV
+// If UseQuaternion is set, Target and UpDir are derived from Orientation (identity looks down -Z)
+// by the quaternion camera functions. A rotation that's applied every frame can be turned into a quaternion once
+// and applied with RotateCameraByQuat, which doesn't need any trig
 struct CameraProperties
 {
     T3DVec3 Position;
@@ -42,6 +62,8 @@ struct CameraProperties
     T3DVec3 UpVector;
     T3DVec3 UpDir;
     float FOV;
+    T3DQuat Orientation;
+    bool UseQuaternion;
 };
 
 // Stores state information about buttons and joysticks
@@ -58,15 +80,35 @@ struct ControllerState
 // Note that the rotation (euler angles here) is in degrees
 // Manually creating a transform is not recommended, you should
 // try to use CreateNewModelTransform and UpdateTransformMatrix
-// wherever possible
+// wherever possible. ModelMatrixFP isn't owned by the transform,
+// it points to the matrix pool slot borrowed by the latest draw.
+// Matrices are only rebuilt when Generation changes, so use the
+// SetTransform* functions (or call MarkTransformDirty after
+// writing Position, Rotation or Scale directly). ModelMatrix only
+// exists when ENGINE_FLOAT_MATRICES is enabled. If UseQuaternion
+// is set, RotationQuat is used instead of the euler angles.
+// SharedRenderBlock is set when RenderBlock belongs to the asset
+// manager (see GetSharedRenderBlock), so it must not be freed
 struct ModelTransform
 {
     rspq_block_t* RenderBlock;
     T3DMat4FP* ModelMatrixFP;
+    T3DMat4FP ModelMatrixFPCache;
+#if ENGINE_FLOAT_MATRICES
     T3DMat4 ModelMatrix;
+#endif
     T3DVec3 Position;
     T3DVec3 Rotation;
+    T3DQuat RotationQuat;
     T3DVec3 Scale;
+    T3DVec3 BoundsMin;
+    T3DVec3 BoundsMax;
+    T3DModel* BoundsModel;
+    uint32_t Generation;
+    uint32_t BuiltGeneration;
+    uint32_t BoundsGeneration;
+    bool UseQuaternion;
+    bool SharedRenderBlock;
 };
 
 struct ModelObject
@@ -75,18 +117,69 @@ struct ModelObject
     T3DModel* Model;
 };
 
+// A set of static model objects baked into one render block, matrices included
+// (see CreateStaticBatch). BoundsMin and BoundsMax cover every object in the batch
+struct StaticBatch
+{
+    rspq_block_t* RenderBlock;
+    T3DMat4FP* Matrices;
+    T3DVec3 BoundsMin;
+    T3DVec3 BoundsMax;
+    int ObjectCount;
+};
+
+// Draws up to MaxInstances copies of one model (see CreateInstanceBatch). RenderBlocks[x] draws 2^x instances, reading
+// their matrices from a contiguous array at INSTANCE_MATRIX_SEGMENT, so any number of instances is drawn with one
+// segment set and one block run per set bit of the count
+struct InstanceBatch
+{
+    T3DModel* Model;
+    rspq_block_t* ModelBlock;
+    rspq_block_t* RenderBlocks[INSTANCE_BATCH_MAX_LEVELS];
+    int LevelCount;
+    int MaxInstances;
+};
+
+// A model object with up to MAX_LOD_LEVELS models, ordered from the most to the least detailed.
+// SwitchDistances[x] is the camera distance where level x + 1 takes over from level x, and
+// Hysteresis is how far past a switch distance the camera has to move before the level changes.
+// SharedRenderBlocks[x] is set when level x's render block belongs to the asset manager
+struct LODModelObject
+{
+    struct ModelTransform Transform;
+    T3DModel* Models[MAX_LOD_LEVELS];
+    rspq_block_t* RenderBlocks[MAX_LOD_LEVELS];
+    bool SharedRenderBlocks[MAX_LOD_LEVELS];
+    float SwitchDistances[MAX_LOD_LEVELS - 1];
+    float Hysteresis;
+    int LevelCount;
+    int CurrentLevel;
+};
+
 extern struct CameraProperties DefaultCameraProperties;
 extern heap_stats_t HeapStats;
+extern MemoryPressureHandler MemoryPressureHook;
+extern T3DFrustum ViewFrustum;
 extern T3DVec3 WorldUpVector;
+extern T3DVec3 ViewPosition;
 extern float CameraClipping[2];
 extern float UsedMemPercentage;
 extern float DeltaTime;
 extern float TargetFPS;
 extern float FOV3D;
 extern float FPS;
+extern bool BufferDebugPrint;
 extern bool ShowMemoryWarnings;
 extern bool VerifyEnoughMemory;
+extern bool EnableFrustumCulling;
+extern bool ViewFrustumIsValid;
+extern uint32_t DisplayBufferCount;
+extern int VisibleModelCount;
+extern int CulledModelCount;
+extern int SkippedMatrixRebuilds;
+extern int MatrixRebuilds;
 extern int FrameCount;
+extern int DebugPrintDroppedBytes;
 
 
 /* FUNCTIONS */
@@ -94,16 +187,35 @@ extern int FrameCount;
 void SetDebugMode(enum EngineDebugModes DebugMode);
 enum EngineDebugModes GetDebugMode();
 void DebugPrint(char* Message, enum EngineDebugModes DebugMode, ...);
+void FlushDebugPrint();
 
 // ----- Engine functions -----
 void InitSystem(resolution_t Resolution, bitdepth_t BitDepth, uint32_t BufferNum, filter_options_t Filters, bool InitDebug);
 void UpdateEngine(struct CameraProperties* CamProps);
 
 // ----- Creation functions -----
+T3DModel* LoadModel(char* ModelPath);
+void FreeModel(T3DModel* Model);
 struct ModelTransform CreateNewModelTransform();
+rspq_block_t* CreateModelRenderBlock(T3DModel* Model, bool* IsShared);
 void AssignNewRenderBlock(struct ModelTransform* Transform, T3DModel* ModelToRender);
 void CreateNewModelObject(struct ModelObject* ModelOBJToUpdate, char* ModelPath);
 void CreateNewModelObjectPredefined(struct ModelObject* ModelOBJToUpdate, T3DModel* Model);
+void CreateNewLODModelObject(struct LODModelObject* LODOBJToUpdate, char* BaseModelPath, float* SwitchDistances, int LevelCount);
+void CreateNewLODModelObjectPredefined(struct LODModelObject* LODOBJToUpdate, T3DModel** Models, float* SwitchDistances, int LevelCount);
+void FreeLODModelObject(struct LODModelObject* LODOBJ);
+void CreateStaticBatch(struct StaticBatch* Batch, struct ModelObject** Objects, int ObjectCount);
+void FreeStaticBatch(struct StaticBatch* Batch);
+void CreateInstanceBatch(struct InstanceBatch* Batch, T3DModel* Model, int MaxInstances);
+void FreeInstanceBatch(struct InstanceBatch* Batch);
+
+// ----- Transform functions -----
+void SetTransformPosition(struct ModelTransform* Transform, T3DVec3 Position);
+void SetTransformRotation(struct ModelTransform* Transform, T3DVec3 Rotation);
+void SetTransformRotationQuat(struct ModelTransform* Transform, T3DQuat Rotation);
+void RotateTransformByQuat(struct ModelTransform* Transform, T3DQuat Rotation);
+void SetTransformScale(struct ModelTransform* Transform, T3DVec3 Scale);
+void MarkTransformDirty(struct ModelTransform* Transform);
 
 // ----- Timing functions -----
 long long UptimeMilliseconds();
@@ -117,6 +229,8 @@ void UpdateCameraDirections(struct CameraProperties* CamProps);
 void RotateCameraToAngle(float XAngle, float YAngle, struct CameraProperties* CamProps);
 void RotateCameraRelative(float XAngle, float YAngle, float ZAngle, struct CameraProperties* CamProps);
 void RotateCameraAroundPoint(float RotationAngle, struct CameraProperties* CamProps, T3DVec3 PointToRotateAround);
+void SetCameraOrientation(struct CameraProperties* CamProps, T3DQuat Orientation);
+void RotateCameraByQuat(struct CameraProperties* CamProps, T3DQuat Rotation, bool LocalSpace);
 void MoveCameraVertical(struct CameraProperties* CamProps, float DistanceStep, bool UseWorldUp);
 void MoveCameraLateral(struct CameraProperties* CamProps, float DistanceStep, bool UseWorldForward);
 void MoveCameraStrafe(struct CameraProperties* CamProps, float DistanceStep, bool UseWorldRight);
@@ -124,8 +238,18 @@ void MoveCameraToPoint(struct CameraProperties* CamProps, T3DVec3);
 
 // ----- Drawing functions -----
 void DrawString(char* Text, int FontID, int XPos, int YPos);
-void RenderModel(struct ModelObject ModelOBJ, bool UpdateMatrix);
+void DrawStringStyled(char* Text, int FontID, int StyleID, int XPos, int YPos);
+void DrawStringImmediate(char* Text, int FontID, int StyleID, int XPos, int YPos);
+void RenderModel(struct ModelObject* ModelOBJ, bool UpdateMatrix);
 void RenderModelWithTransform(T3DModel* ModelToRender, struct ModelTransform* Transform, bool UpdateMatrix);
+void RenderModelUnculled(T3DModel* ModelToRender, struct ModelTransform* Transform);
+T3DMat4FP* RenderModelMatrix(T3DModel* ModelToRender, rspq_block_t* RenderBlock, const T3DMat4FP* Matrix);
+void RenderModelInstances(struct InstanceBatch* Batch, struct ModelTransform* Transforms, int InstanceCount, bool UpdateMatrices);
+void RenderLODModel(struct LODModelObject* LODOBJ, bool UpdateMatrix);
+void RenderStaticBatch(struct StaticBatch* Batch);
+bool IsModelVisible(T3DModel* Model, struct ModelTransform* Transform);
+bool IsBoundsVisible(T3DVec3* BoundsMin, T3DVec3* BoundsMax);
+float GetTransformViewDepth(struct ModelTransform* Transform);
 void ClearScreen(color_t ClearColor);
 void UpdateLightProperties(int LightCount, uint8_t* GlobalLightColor, uint8_t* SunColor, T3DVec3* SunDirection);
 void UpdateViewport(T3DViewport* Viewport, struct CameraProperties CamProps);
@@ -0,0 +1,351 @@
+/* N64 GAME ENGINE */
+// Frame profiler file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <string.h>
+#include <libdragon.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "Profiler.h"
+
+
+/* DEFINITIONS */
+// The RDP's performance counters. They count RDP clock cycles (62.5 MHz) and are only 24 bits wide, so they wrap
+// around after ~268ms. Writing the reset bits to DP_STATUS clears them without touching anything else
+#define PROFILER_DP_STATUS ((volatile uint32_t*)0xA410000C)
+#define PROFILER_DP_CLOCK ((volatile uint32_t*)0xA4100010)
+#define PROFILER_DP_PIPE_BUSY ((volatile uint32_t*)0xA4100018)
+#define PROFILER_DP_RESET_COUNTERS ((1 << 6) | (1 << 7) | (1 << 8) | (1 << 9))
+#define PROFILER_DP_COUNTER_MASK 0xFFFFFF
+
+#define PROFILER_OTHER_COLOR RGBA32(0x40, 0x40, 0x40, 0xFF) // Frame time that isn't in any zone
+#define PROFILER_RDP_COLOR RGBA32(0xFF, 0x20, 0x20, 0xFF)
+#define PROFILER_TARGET_COLOR RGBA32(0xFF, 0xFF, 0xFF, 0xFF)
+#define PROFILER_BACKGROUND_COLOR RGBA32(0x00, 0x00, 0x00, 0xFF)
+
+
+/* VARIABLES */
+struct ProfileEvent ProfileEvents[PROFILER_EVENT_BUFFER_SIZE];
+struct ProfileFrame ProfileFrames[PROFILER_HISTORY_FRAMES];
+struct ProfileFrame CurrentProfileFrame;
+const char* ProfileZoneNames[PROFILER_MAX_ZONES] = {
+    "StartFrame",
+    "UpdateEngine",
+    "RenderModel",
+    "Text",
+    "EndFrame",
+    "AssetLoads"
+};
+color_t ProfileZoneColors[PROFILER_MAX_ZONES] = {
+    RGBA32(0x20, 0x60, 0xFF, 0xFF),
+    RGBA32(0x00, 0xC0, 0x40, 0xFF),
+    RGBA32(0xFF, 0xA5, 0x00, 0xFF),
+    RGBA32(0xC0, 0x40, 0xFF, 0xFF),
+    RGBA32(0x00, 0xD0, 0xD0, 0xFF),
+    RGBA32(0xFF, 0x60, 0xA0, 0xFF)
+};
+uint64_t ProfileStackStart[PROFILER_MAX_DEPTH];
+uint32_t ProfileStackChildTicks[PROFILER_MAX_DEPTH];
+uint32_t ProfileEventTotal = 0;
+bool ProfilerStarted = false;
+int ProfileStackZones[PROFILER_MAX_DEPTH];
+int ProfileStackDepth = 0;
+int ProfileFramesRecorded = 0;
+int ProfileZoneCount = PROFILE_ENGINE_ZONE_COUNT;
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Convert timer ticks to milliseconds
+float ProfileTicksToMS(uint32_t Ticks)
+{
+    return TIMER_MICROS_LL(Ticks) / 1000.0f;
+}
+
+// Convert RDP clock cycles (62.5 MHz) to timer ticks (46.875 MHz)
+uint32_t RDPCyclesToTicks(uint32_t Cycles)
+{
+    return (uint64_t)Cycles * 3 / 4;
+}
+
+// Add an event to the ring buffer. Once the buffer wraps around, the oldest frames' events are overwritten
+void RecordProfileEvent(int Zone, bool Begin, uint64_t Ticks)
+{
+    struct ProfileEvent* Event = &ProfileEvents[ProfileEventTotal % PROFILER_EVENT_BUFFER_SIZE];
+
+    Event->Ticks = Ticks;
+    Event->Zone = Zone;
+    Event->Begin = Begin;
+    ProfileEventTotal++;
+}
+
+// ----- Zone functions -----
+// Add a zone for game code to time with PROFILE_BEGIN and PROFILE_END, and return its ID. Name isn't copied, so it
+// should be a string literal. Color is the zone's color in the profiler graph
+int RegisterProfileZone(const char* Name, color_t Color)
+{
+    assertf(ProfileZoneCount < PROFILER_MAX_ZONES, "Too many profile zones (the limit is %d)!", PROFILER_MAX_ZONES);
+
+    ProfileZoneNames[ProfileZoneCount] = Name;
+    ProfileZoneColors[ProfileZoneCount] = Color;
+    return ProfileZoneCount++;
+}
+
+// Get the name of a zone
+const char* GetProfileZoneName(int Zone)
+{
+    if (Zone < 0 || Zone >= ProfileZoneCount)
+    {
+        return "Unknown";
+    }
+
+    return ProfileZoneNames[Zone];
+}
+
+// Start timing a zone. Use PROFILE_BEGIN instead of calling this directly, so the call can be compiled out
+void BeginProfileZone(int Zone)
+{
+    assertf(ProfileStackDepth < PROFILER_MAX_DEPTH, "Profile zones are nested too deep (the limit is %d)!", PROFILER_MAX_DEPTH);
+
+    uint64_t Now = timer_ticks();
+
+    ProfileStackZones[ProfileStackDepth] = Zone;
+    ProfileStackStart[ProfileStackDepth] = Now;
+    ProfileStackChildTicks[ProfileStackDepth] = 0;
+    ProfileStackDepth++;
+    RecordProfileEvent(Zone, true, Now);
+}
+
+// Stop timing a zone, which has to be the innermost zone that's still open. The time spent in nested zones is
+// subtracted from this zone's time and added to the enclosing zone's nested time instead
+void EndProfileZone(int Zone)
+{
+    uint64_t Now = timer_ticks();
+
+    assertf(ProfileStackDepth > 0 && ProfileStackZones[ProfileStackDepth - 1] == Zone, "Profile zone \"%s\" was ended out of order!", GetProfileZoneName(Zone));
+
+    ProfileStackDepth--;
+
+    uint32_t Elapsed = Now - ProfileStackStart[ProfileStackDepth];
+
+    CurrentProfileFrame.ZoneTicks[Zone] += Elapsed - ProfileStackChildTicks[ProfileStackDepth];
+    CurrentProfileFrame.ZoneCalls[Zone]++;
+
+    if (ProfileStackDepth > 0)
+    {
+        ProfileStackChildTicks[ProfileStackDepth - 1] += Elapsed;
+    }
+
+    RecordProfileEvent(Zone, false, Now);
+}
+
+// ----- Frame functions -----
+// Finish the current profiler frame and start the next one. This is called by StartFrame, so every zone has to be
+// ended before then. The RDP counters cover the same stretch of time, which means they mostly measure the RDP working
+// through the previous frame's commands (it runs behind the CPU)
+void NextProfilerFrame()
+{
+    uint64_t Now = timer_ticks();
+
+    assertf(ProfileStackDepth == 0, "Profile zone \"%s\" is still open at the start of a frame!", GetProfileZoneName(ProfileStackZones[ProfileStackDepth - 1]));
+
+    if (ProfilerStarted == true)
+    {
+        CurrentProfileFrame.FrameTicks = Now - CurrentProfileFrame.StartTicks;
+        CurrentProfileFrame.RDPBusyTicks = RDPCyclesToTicks(*PROFILER_DP_PIPE_BUSY & PROFILER_DP_COUNTER_MASK);
+        CurrentProfileFrame.RDPClockTicks = RDPCyclesToTicks(*PROFILER_DP_CLOCK & PROFILER_DP_COUNTER_MASK);
+        CurrentProfileFrame.EventCount = ProfileEventTotal - CurrentProfileFrame.FirstEvent;
+
+        ProfileFrames[ProfileFramesRecorded % PROFILER_HISTORY_FRAMES] = CurrentProfileFrame;
+        ProfileFramesRecorded++;
+    }
+
+    *PROFILER_DP_STATUS = PROFILER_DP_RESET_COUNTERS;
+
+    memset(&CurrentProfileFrame, 0, sizeof(struct ProfileFrame));
+    CurrentProfileFrame.StartTicks = Now;
+    CurrentProfileFrame.FirstEvent = ProfileEventTotal;
+    CurrentProfileFrame.FrameNumber = FrameCount;
+    ProfilerStarted = true;
+}
+
+// Get a finished frame, where 0 is the latest one. NULL is returned if the frame isn't kept anymore (or yet)
+struct ProfileFrame* GetProfileFrame(int FramesAgo)
+{
+    if (FramesAgo < 0 || FramesAgo >= MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES))
+    {
+        return NULL;
+    }
+
+    return &ProfileFrames[(ProfileFramesRecorded - 1 - FramesAgo) % PROFILER_HISTORY_FRAMES];
+}
+
+// Get the average time spent in a zone per frame (in milliseconds), over every kept frame
+float GetProfileZoneMS(int Zone)
+{
+    int FrameTotal = MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES);
+    uint64_t Ticks = 0;
+
+    if (FrameTotal == 0)
+    {
+        return 0.0f;
+    }
+
+    for (int FrameIndex = 0; FrameIndex < FrameTotal; FrameIndex++)
+    {
+        Ticks += ProfileFrames[FrameIndex].ZoneTicks[Zone];
+    }
+
+    return ProfileTicksToMS(Ticks / FrameTotal);
+}
+
+// Get the average frame time (in milliseconds), over every kept frame
+float GetProfileFrameMS()
+{
+    int FrameTotal = MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES);
+    uint64_t Ticks = 0;
+
+    if (FrameTotal == 0)
+    {
+        return 0.0f;
+    }
+
+    for (int FrameIndex = 0; FrameIndex < FrameTotal; FrameIndex++)
+    {
+        Ticks += ProfileFrames[FrameIndex].FrameTicks;
+    }
+
+    return ProfileTicksToMS(Ticks / FrameTotal);
+}
+
+// Get the average time the RDP spent busy per frame (in milliseconds), over every kept frame
+float GetProfileRDPBusyMS()
+{
+    int FrameTotal = MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES);
+    uint64_t Ticks = 0;
+
+    if (FrameTotal == 0)
+    {
+        return 0.0f;
+    }
+
+    for (int FrameIndex = 0; FrameIndex < FrameTotal; FrameIndex++)
+    {
+        Ticks += ProfileFrames[FrameIndex].RDPBusyTicks;
+    }
+
+    return ProfileTicksToMS(Ticks / FrameTotal);
+}
+
+// ----- Output functions -----
+// Draw a bar graph of the kept frames, oldest on the left. Every bar stacks the frame's zone times (bottom to top in
+// zone order) with the time outside of any zone on top, and the red mark shows how long the RDP was busy. The graph is
+// two target frame times tall, and the white line is the target frame time. This must be called in 2D mode
+void DrawProfilerGraph(int XPos, int YPos, int Width, int Height)
+{
+    int FrameTotal = MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES);
+    float BarWidth = (float)Width / PROFILER_HISTORY_FRAMES;
+    float TargetTicks = TICKS_PER_SECOND / TargetFPS;
+    float Scale = Height / (TargetTicks * 2.0f);
+    float GraphBottom = YPos + Height;
+
+    rdpq_mode_push();
+    rdpq_set_mode_fill(PROFILER_BACKGROUND_COLOR);
+    rdpq_fill_rectangle(XPos, YPos, XPos + Width, GraphBottom);
+
+    for (int BarIndex = 0; BarIndex < FrameTotal; BarIndex++)
+    {
+        struct ProfileFrame* Frame = GetProfileFrame(FrameTotal - 1 - BarIndex);
+        float Left = XPos + (BarIndex * BarWidth);
+        float Right = Left + MAX(BarWidth - 1.0f, 1.0f);
+        float Bottom = GraphBottom;
+        uint32_t ZonedTicks = 0;
+
+        for (int Zone = 0; Zone <= ProfileZoneCount; Zone++)
+        {
+            uint32_t Ticks;
+
+            // The extra zone at the end is the time that wasn't spent in any zone
+            if (Zone == ProfileZoneCount)
+            {
+                Ticks = Frame->FrameTicks > ZonedTicks ? Frame->FrameTicks - ZonedTicks : 0;
+                rdpq_set_fill_color(PROFILER_OTHER_COLOR);
+            }
+            else
+            {
+                Ticks = Frame->ZoneTicks[Zone];
+                ZonedTicks += Ticks;
+                rdpq_set_fill_color(ProfileZoneColors[Zone]);
+            }
+
+            float Top = MAX(Bottom - (Ticks * Scale), (float)YPos);
+
+            if (Top < Bottom)
+            {
+                rdpq_fill_rectangle(Left, Top, Right, Bottom);
+                Bottom = Top;
+            }
+        }
+
+        float RDPMark = MAX(GraphBottom - (Frame->RDPBusyTicks * Scale), (float)YPos);
+
+        rdpq_set_fill_color(PROFILER_RDP_COLOR);
+        rdpq_fill_rectangle(Left, RDPMark, Right, RDPMark + 1.0f);
+    }
+
+    rdpq_set_fill_color(PROFILER_TARGET_COLOR);
+    rdpq_fill_rectangle(XPos, YPos + (Height / 2), XPos + Width, YPos + (Height / 2) + 1);
+    rdpq_mode_pop();
+}
+
+// Write every kept frame to the console so it can be looked at offline. All times are in microseconds, and event times
+// are relative to the start of their frame. A frame's events are only written if they're still in the ring buffer:
+//  #PROFILE-ZONE <Zone> <Name>
+//  #PROFILE-FRAME <Frame number> <Frame time> <RDP busy time> <Event count>
+//  #PROFILE-TIME <Zone> <Time> <Calls>
+//  #PROFILE-EVENT <Zone> <B (begin) or E (end)> <Time>
+void DumpProfiler()
+{
+    int FrameTotal = MIN(ProfileFramesRecorded, PROFILER_HISTORY_FRAMES);
+
+    for (int Zone = 0; Zone < ProfileZoneCount; Zone++)
+    {
+        DebugPrint("#PROFILE-ZONE %d %s\n", MINIMAL, Zone, GetProfileZoneName(Zone));
+    }
+
+    for (int FramesAgo = FrameTotal - 1; FramesAgo >= 0; FramesAgo--)
+    {
+        struct ProfileFrame* Frame = GetProfileFrame(FramesAgo);
+
+        DebugPrint("#PROFILE-FRAME %d %d %d %d\n", MINIMAL, Frame->FrameNumber, (int)TIMER_MICROS_LL(Frame->FrameTicks), (int)TIMER_MICROS_LL(Frame->RDPBusyTicks), (int)Frame->EventCount);
+
+        for (int Zone = 0; Zone < ProfileZoneCount; Zone++)
+        {
+            if (Frame->ZoneCalls[Zone] > 0)
+            {
+                DebugPrint("#PROFILE-TIME %d %d %d\n", MINIMAL, Zone, (int)TIMER_MICROS_LL(Frame->ZoneTicks[Zone]), Frame->ZoneCalls[Zone]);
+            }
+        }
+
+        // Events older than the ring buffer's size have been overwritten already
+        if (ProfileEventTotal - Frame->FirstEvent > PROFILER_EVENT_BUFFER_SIZE)
+        {
+            continue;
+        }
+
+        for (uint32_t EventIndex = Frame->FirstEvent; EventIndex != Frame->FirstEvent + Frame->EventCount; EventIndex++)
+        {
+            struct ProfileEvent* Event = &ProfileEvents[EventIndex % PROFILER_EVENT_BUFFER_SIZE];
+
+            DebugPrint("#PROFILE-EVENT %d %c %d\n", MINIMAL, Event->Zone, Event->Begin == true ? 'B' : 'E', (int)TIMER_MICROS_LL(Event->Ticks - Frame->StartTicks));
+        }
+    }
+
+    FlushDebugPrint();
+}
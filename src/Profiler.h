@@ -0,0 +1,104 @@
+/* N64 GAME ENGINE */
+// Frame profiler header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+//
+// Code between PROFILE_BEGIN(Zone) and PROFILE_END(Zone) is timed with timer_ticks. Every begin and end is recorded
+// into an event ring buffer, and each zone's time is added up per frame (excluding the time spent in zones nested
+// inside it, so the zones of a frame can be stacked without counting anything twice). A frame runs from one StartFrame
+// call to the next, so the time spent outside of every zone (game logic, waiting for vsync) shows up as "other".
+//
+// The RDP's busy time is read from its hardware counters every frame. The RSP doesn't have counters like these, so
+// its time isn't captured. The results can be drawn with DrawProfilerGraph, or written to the console with DumpProfiler
+//
+// Set ENGINE_PROFILER to 0 to compile every PROFILE_BEGIN and PROFILE_END call out
+
+
+// Define PROFILER_H if it hasn't been already
+#ifndef PROFILER_H
+#define PROFILER_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#ifndef ENGINE_PROFILER
+#define ENGINE_PROFILER 1
+#endif
+
+#define PROFILER_MAX_ZONES 16 // The maximum number of zones, the engine's own zones included
+#define PROFILER_MAX_DEPTH 16 // The maximum number of zones that can be nested inside each other
+#define PROFILER_HISTORY_FRAMES 32 // The number of finished frames that are kept
+#define PROFILER_EVENT_BUFFER_SIZE 1024 // The number of begin/end events the ring buffer holds (across all kept frames), has to be a power of 2
+
+#if ENGINE_PROFILER
+#define PROFILE_BEGIN(Zone) BeginProfileZone(Zone)
+#define PROFILE_END(Zone) EndProfileZone(Zone)
+#else
+#define PROFILE_BEGIN(Zone) do { } while (0)
+#define PROFILE_END(Zone) do { } while (0)
+#endif
+
+
+/* VARIABLES */
+// The zones the engine times itself. Zones registered with RegisterProfileZone come after these
+enum EngineProfileZones
+{
+    PROFILE_ZONE_START_FRAME,
+    PROFILE_ZONE_UPDATE_ENGINE,
+    PROFILE_ZONE_RENDER_MODEL,
+    PROFILE_ZONE_TEXT,
+    PROFILE_ZONE_END_FRAME,
+    PROFILE_ZONE_ASSET_LOADS,
+    PROFILE_ENGINE_ZONE_COUNT
+};
+
+// A single zone begin or end. Ticks is the timer_ticks value it was recorded at
+struct ProfileEvent
+{
+    uint64_t Ticks;
+    uint8_t Zone;
+    bool Begin;
+};
+
+// The results of one finished frame. ZoneTicks is the time spent in each zone (minus the time spent in zones nested
+// inside it), and the RDP times are converted to timer ticks. FirstEvent is the total event count when the frame started
+struct ProfileFrame
+{
+    uint64_t StartTicks;
+    uint32_t FrameTicks;
+    uint32_t ZoneTicks[PROFILER_MAX_ZONES];
+    uint16_t ZoneCalls[PROFILER_MAX_ZONES];
+    uint32_t RDPBusyTicks;
+    uint32_t RDPClockTicks;
+    uint32_t FirstEvent;
+    uint32_t EventCount;
+    int FrameNumber;
+};
+
+extern int ProfileZoneCount;
+
+
+/* FUNCTIONS */
+// ----- Zone functions -----
+int RegisterProfileZone(const char* Name, color_t Color);
+const char* GetProfileZoneName(int Zone);
+void BeginProfileZone(int Zone);
+void EndProfileZone(int Zone);
+
+// ----- Frame functions -----
+void NextProfilerFrame();
+struct ProfileFrame* GetProfileFrame(int FramesAgo);
+float GetProfileZoneMS(int Zone);
+float GetProfileFrameMS();
+float GetProfileRDPBusyMS();
+
+// ----- Output functions -----
+void DrawProfilerGraph(int XPos, int YPos, int Width, int Height);
+void DumpProfiler();
+#endif
@@ -0,0 +1,230 @@
+/* N64 GAME ENGINE */
+// Render queue file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <string.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
+#include "N64GameEngine.h"
+#include "MemoryUtils.h"
+#include "RenderQueue.h"
+
+
+/* VARIABLES */
+struct RenderQueueItem QueuedModels[RENDER_QUEUE_CAPACITY];
+struct RenderQueueText QueuedStrings[RENDER_QUEUE_TEXT_CAPACITY];
+bool UseRenderQueue = false;
+int RenderQueueStateChangesSaved = 0;
+int QueuedModelCount = 0;
+int QueuedStringCount = 0;
+int NextStringOrder = 0;
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Count the parts of a material's state (combiner, render mode, render flags and both textures) that are the same as
+// another material's, which are the parts t3d_model_draw_material doesn't have to set again. A NULL material (nothing
+// applied yet) matches nothing
+int CountMatchingMaterialStates(T3DMaterial* Material, T3DMaterial* Previous)
+{
+    if (Previous == NULL)
+    {
+        return 0;
+    }
+
+    return (Material->colorCombiner == Previous->colorCombiner) +
+           (Material->otherModeValue == Previous->otherModeValue) +
+           (Material->renderFlags == Previous->renderFlags) +
+           (Material->textureA.textureHash == Previous->textureA.textureHash) +
+           (Material->textureB.textureHash == Previous->textureB.textureHash);
+}
+
+// Sort order for queued models. Opaque models come first, grouped by material and then drawn front to back so the
+// depth buffer rejects as many hidden pixels as possible. Transparent models come last and are drawn back to front
+int CompareQueuedModels(const void* A, const void* B)
+{
+    const struct RenderQueueItem* Item1 = A;
+    const struct RenderQueueItem* Item2 = B;
+
+    if (Item1->IsTransparent != Item2->IsTransparent)
+    {
+        return Item1->IsTransparent ? 1 : -1;
+    }
+
+    if (Item1->IsTransparent == true)
+    {
+        return (Item1->Depth < Item2->Depth) - (Item1->Depth > Item2->Depth);
+    }
+
+    if (Item1->MaterialKey != Item2->MaterialKey)
+    {
+        return Item1->MaterialKey < Item2->MaterialKey ? -1 : 1;
+    }
+
+    return (Item1->Depth > Item2->Depth) - (Item1->Depth < Item2->Depth);
+}
+
+// Sort order for queued strings. Strings are grouped by font and style, but keep their call order within a group
+// (qsort isn't stable, so the order they were queued in is the last tiebreak)
+int CompareQueuedStrings(const void* A, const void* B)
+{
+    const struct RenderQueueText* Text1 = A;
+    const struct RenderQueueText* Text2 = B;
+
+    if (Text1->FontID != Text2->FontID)
+    {
+        return Text1->FontID - Text2->FontID;
+    }
+
+    if (Text1->StyleID != Text2->StyleID)
+    {
+        return Text1->StyleID - Text2->StyleID;
+    }
+
+    return Text1->Order - Text2->Order;
+}
+
+// ----- Queue functions -----
+// Queue a model to be drawn with a matrix when the 3D queue is flushed. If the queue is full, it's flushed early
+void QueueModel(T3DModel* Model, T3DMat4FP* Matrix, float Depth)
+{
+    if (QueuedModelCount >= RENDER_QUEUE_CAPACITY)
+    {
+        FlushRenderQueue3D();
+    }
+
+    struct RenderQueueItem* NewItem = &QueuedModels[QueuedModelCount++];
+    T3DModelIter ObjectIterator = t3d_model_iter_create(Model, T3D_CHUNK_TYPE_OBJECT);
+
+    NewItem->Model = Model;
+    NewItem->Matrix = Matrix;
+    NewItem->Depth = Depth;
+    NewItem->FirstMaterial = NULL;
+    NewItem->MaterialKey = 0;
+    NewItem->IsTransparent = false;
+
+    // The first material decides where the model is sorted
+    if (t3d_model_iter_next(&ObjectIterator) == true)
+    {
+        T3DMaterial* Material = ObjectIterator.object->material;
+
+        NewItem->FirstMaterial = Material;
+        NewItem->MaterialKey = ((uint64_t)Material->textureA.textureHash << 32) ^ Material->colorCombiner ^ Material->otherModeValue;
+        NewItem->IsTransparent = Material->alphaMode == T3D_ALPHA_MODE_TRANSP;
+    }
+}
+
+// Queue a string to be drawn when the 2D queue is flushed. The string is copied, so it doesn't need to outlive the call.
+// If the queue is full, it's flushed early
+void QueueString(char* Text, int FontID, int StyleID, int XPos, int YPos)
+{
+    if (QueuedStringCount >= RENDER_QUEUE_TEXT_CAPACITY)
+    {
+        FlushRenderQueue2D();
+    }
+
+    struct RenderQueueText* NewText = &QueuedStrings[QueuedStringCount++];
+
+    NewText->Text = FrameStrdup(Text);
+    NewText->FontID = FontID;
+    NewText->StyleID = StyleID;
+    NewText->XPos = XPos;
+    NewText->YPos = YPos;
+    NewText->Order = NextStringOrder++;
+}
+
+// Check if there are no queued models
+bool IsRenderQueue3DEmpty()
+{
+    return QueuedModelCount == 0;
+}
+
+// Check if there are no queued strings
+bool IsRenderQueue2DEmpty()
+{
+    return QueuedStringCount == 0;
+}
+
+// ----- Flush functions -----
+// Sort and draw every queued model. All models share one T3D model state, so a material's state is only applied where
+// it differs from the material drawn before it, even across models (t3d_model_draw starts every model from scratch).
+// Like t3d_model_draw, invisible objects are skipped and the vertex effect is reset at the end. This must be called
+// in 3D mode
+void FlushRenderQueue3D()
+{
+    if (QueuedModelCount == 0)
+    {
+        return;
+    }
+
+    T3DModelState ModelState = t3d_model_state_create();
+    T3DMaterial* LastMaterial = NULL;
+
+    qsort(QueuedModels, QueuedModelCount, sizeof(struct RenderQueueItem), CompareQueuedModels);
+
+    for (int ItemIndex = 0; ItemIndex < QueuedModelCount; ItemIndex++)
+    {
+        struct RenderQueueItem* Item = &QueuedModels[ItemIndex];
+        T3DModelIter ObjectIterator = t3d_model_iter_create(Item->Model, T3D_CHUNK_TYPE_OBJECT);
+        T3DMaterial* LastModelMaterial = NULL;
+
+        t3d_matrix_push(Item->Matrix);
+
+        while (t3d_model_iter_next(&ObjectIterator) == true)
+        {
+            T3DMaterial* Material = ObjectIterator.object->material;
+
+            if (ObjectIterator.object->isVisible == false)
+            {
+                continue;
+            }
+
+            // Drawn on its own, the model would only have skipped the states it shares with its own previous material
+            RenderQueueStateChangesSaved += CountMatchingMaterialStates(Material, LastMaterial) - CountMatchingMaterialStates(Material, LastModelMaterial);
+            t3d_model_draw_material(Material, &ModelState);
+            t3d_model_draw_object(ObjectIterator.object, NULL);
+            LastMaterial = Material;
+            LastModelMaterial = Material;
+        }
+
+        t3d_matrix_pop(1);
+    }
+
+    if (ModelState.lastVertFXFunc != T3D_VERTEX_FX_NONE)
+    {
+        t3d_state_set_vertex_fx(T3D_VERTEX_FX_NONE, 0, 0);
+    }
+
+    QueuedModelCount = 0;
+}
+
+// Draw every queued string, grouped by font and style. Each string is still rendered as its own paragraph, which sets
+// up the font's render state again, so this doesn't count towards RenderQueueStateChangesSaved. This must be called in
+// 2D mode
+void FlushRenderQueue2D()
+{
+    if (QueuedStringCount == 0)
+    {
+        return;
+    }
+
+    qsort(QueuedStrings, QueuedStringCount, sizeof(struct RenderQueueText), CompareQueuedStrings);
+
+    for (int TextIndex = 0; TextIndex < QueuedStringCount; TextIndex++)
+    {
+        struct RenderQueueText* Text = &QueuedStrings[TextIndex];
+
+        DrawStringImmediate(Text->Text, Text->FontID, Text->StyleID, Text->XPos, Text->YPos);
+    }
+
+    QueuedStringCount = 0;
+    NextStringOrder = 0;
+}
@@ -0,0 +1,61 @@
+/* N64 GAME ENGINE */
+// Render queue header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define RENDERQUEUE_H if it hasn't been already
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define RENDER_QUEUE_CAPACITY 256 // The maximum number of queued models before the queue is flushed early
+#define RENDER_QUEUE_TEXT_CAPACITY 32 // The maximum number of queued strings before the queue is flushed early
+
+
+/* VARIABLES */
+// A queued model draw. The matrix is borrowed from the matrix pool, so it's valid for the whole frame
+struct RenderQueueItem
+{
+    T3DModel* Model;
+    T3DMat4FP* Matrix;
+    T3DMaterial* FirstMaterial;
+    uint64_t MaterialKey;
+    float Depth;
+    bool IsTransparent;
+};
+
+// A queued string draw. Text is a copy in the frame arena, and Order is the number of strings queued before it this frame
+struct RenderQueueText
+{
+    char* Text;
+    int FontID;
+    int StyleID;
+    int XPos;
+    int YPos;
+    int Order;
+};
+
+extern bool UseRenderQueue;
+extern int RenderQueueStateChangesSaved;
+
+
+/* FUNCTIONS */
+// ----- Queue functions -----
+void QueueModel(T3DModel* Model, T3DMat4FP* Matrix, float Depth);
+void QueueString(char* Text, int FontID, int StyleID, int XPos, int YPos);
+bool IsRenderQueue3DEmpty();
+bool IsRenderQueue2DEmpty();
+
+// ----- Flush functions -----
+void FlushRenderQueue3D();
+void FlushRenderQueue2D();
+#endif
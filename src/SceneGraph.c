@@ -0,0 +1,189 @@
+/* N64 GAME ENGINE */
+// Scene graph file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "SceneGraph.h"
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+// Creates an empty scene graph that can hold up to Capacity nodes
+void CreateSceneGraph(struct SceneGraph* Graph, int Capacity)
+{
+    Graph->Nodes = TaggedMalloc(sizeof(struct SceneNode) * Capacity, MEMORY_TAG_SCENE);
+    Graph->NodeCount = 0;
+    Graph->Capacity = Capacity;
+
+    assertf(Graph->Nodes != NULL, "Failed to allocate a scene graph with %d nodes!", Capacity);
+}
+
+// Frees a scene graph's nodes. Render blocks are freed too (except shared ones, which belong to the asset manager), so make sure the RSP is done with them
+void FreeSceneGraph(struct SceneGraph* Graph)
+{
+    rspq_wait();
+
+    for (int NodeIndex = 0; NodeIndex < Graph->NodeCount; NodeIndex++)
+    {
+        if (Graph->Nodes[NodeIndex].RenderBlock != NULL && Graph->Nodes[NodeIndex].SharedRenderBlock == false)
+        {
+            UntrackAllocation(Graph->Nodes[NodeIndex].RenderBlock);
+            rspq_block_free(Graph->Nodes[NodeIndex].RenderBlock);
+        }
+    }
+
+    TaggedFree(Graph->Nodes);
+    Graph->Nodes = NULL;
+    Graph->NodeCount = 0;
+    Graph->Capacity = 0;
+}
+
+// Adds a node to a scene graph and returns its index. The parent has to already be in the graph (or be
+// SCENE_NODE_NONE for a root node), which keeps every parent in front of its children. Model can be NULL
+// for nodes that only group other nodes
+int AddSceneNode(struct SceneGraph* Graph, int Parent, T3DModel* Model)
+{
+    assertf(Graph->NodeCount < Graph->Capacity, "The scene graph is full (%d nodes)!", Graph->Capacity);
+    assertf(Parent >= SCENE_NODE_NONE && Parent < Graph->NodeCount, "Invalid scene node parent (%d)!", Parent);
+
+    struct SceneNode* NewNode = &Graph->Nodes[Graph->NodeCount];
+
+    NewNode->Position = (T3DVec3){{0.0f, 0.0f, 0.0f}};
+    NewNode->Rotation = (T3DVec3){{0.0f, 0.0f, 0.0f}};
+    NewNode->Scale = (T3DVec3){{1.0f, 1.0f, 1.0f}};
+    NewNode->BoundsMin = (T3DVec3){{0.0f, 0.0f, 0.0f}};
+    NewNode->BoundsMax = (T3DVec3){{0.0f, 0.0f, 0.0f}};
+    NewNode->RenderBlock = NULL;
+    NewNode->SharedRenderBlock = false;
+    NewNode->Model = Model;
+    NewNode->Parent = Parent;
+    NewNode->LocalDirty = true;
+    NewNode->WorldDirty = true;
+
+    if (Model != NULL)
+    {
+        NewNode->RenderBlock = CreateModelRenderBlock(Model, &NewNode->SharedRenderBlock);
+    }
+
+    t3d_mat4_identity(&NewNode->LocalMatrix);
+    t3d_mat4_identity(&NewNode->WorldMatrix);
+    t3d_mat4fp_identity(&NewNode->WorldMatrixFP);
+    return Graph->NodeCount++;
+}
+
+// ----- Node functions -----
+// Set a node's position (relative to its parent)
+void SetSceneNodePosition(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Position)
+{
+    Graph->Nodes[NodeIndex].Position = Position;
+    Graph->Nodes[NodeIndex].LocalDirty = true;
+}
+
+// Set a node's rotation (euler angles in degrees, relative to its parent)
+void SetSceneNodeRotation(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Rotation)
+{
+    Graph->Nodes[NodeIndex].Rotation = Rotation;
+    Graph->Nodes[NodeIndex].LocalDirty = true;
+}
+
+// Set a node's scale (relative to its parent)
+void SetSceneNodeScale(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Scale)
+{
+    Graph->Nodes[NodeIndex].Scale = Scale;
+    Graph->Nodes[NodeIndex].LocalDirty = true;
+}
+
+// Mark a node's local matrix for rebuilding. This must be called after writing to Position, Rotation or Scale directly
+void MarkSceneNodeDirty(struct SceneGraph* Graph, int NodeIndex)
+{
+    Graph->Nodes[NodeIndex].LocalDirty = true;
+}
+
+// Get a node's world space position (as of the last UpdateSceneGraph call)
+T3DVec3 GetSceneNodeWorldPosition(struct SceneGraph* Graph, int NodeIndex)
+{
+    T3DMat4* WorldMatrix = &Graph->Nodes[NodeIndex].WorldMatrix;
+
+    return (T3DVec3){{WorldMatrix->m[3][0], WorldMatrix->m[3][1], WorldMatrix->m[3][2]}};
+}
+
+// ----- Update functions -----
+// Rebuild the world matrices (and bounds) of every node that needs it. A node's world matrix is only recalculated when
+// its own local SRT data or one of its ancestors changed, and its local matrix only when its own SRT data changed, so
+// the children of a moved node only cost a matrix multiply each. Because parents are stored before their children, a
+// parent's WorldDirty flag is always up to date by the time its children are visited
+void UpdateSceneGraph(struct SceneGraph* Graph)
+{
+    for (int NodeIndex = 0; NodeIndex < Graph->NodeCount; NodeIndex++)
+    {
+        struct SceneNode* Node = &Graph->Nodes[NodeIndex];
+        struct SceneNode* ParentNode = Node->Parent != SCENE_NODE_NONE ? &Graph->Nodes[Node->Parent] : NULL;
+
+        Node->WorldDirty = Node->LocalDirty || (ParentNode != NULL && ParentNode->WorldDirty);
+
+        if (Node->WorldDirty == false)
+        {
+            SkippedMatrixRebuilds++;
+            continue;
+        }
+
+        if (Node->LocalDirty == true)
+        {
+            Node->LocalMatrix = CreateSRTMatrix(Node->Position, Node->Rotation, Node->Scale);
+            Node->LocalDirty = false;
+        }
+
+        if (ParentNode != NULL)
+        {
+            t3d_mat4_mul(&Node->WorldMatrix, &ParentNode->WorldMatrix, &Node->LocalMatrix);
+        }
+        else
+        {
+            Node->WorldMatrix = Node->LocalMatrix;
+        }
+
+        t3d_mat4_to_fixed(&Node->WorldMatrixFP, &Node->WorldMatrix);
+
+        if (Node->Model != NULL)
+        {
+            GetModelWorldBounds(Node->Model, &Node->WorldMatrixFP, &Node->BoundsMin, &Node->BoundsMax);
+        }
+
+        MatrixRebuilds++;
+    }
+}
+
+// Render every node that has a model and is inside of the view frustum, using the world matrices built by the last
+// UpdateSceneGraph call
+void RenderSceneGraph(struct SceneGraph* Graph)
+{
+    for (int NodeIndex = 0; NodeIndex < Graph->NodeCount; NodeIndex++)
+    {
+        struct SceneNode* Node = &Graph->Nodes[NodeIndex];
+
+        if (Node->Model == NULL)
+        {
+            continue;
+        }
+
+        if (IsBoundsVisible(&Node->BoundsMin, &Node->BoundsMax) == false)
+        {
+            CulledModelCount++;
+            continue;
+        }
+
+        RenderModelMatrix(Node->Model, Node->RenderBlock, &Node->WorldMatrixFP);
+    }
+}
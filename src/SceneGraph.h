@@ -0,0 +1,74 @@
+/* N64 GAME ENGINE */
+// Scene graph header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define SCENEGRAPH_H if it hasn't been already
+#ifndef SCENEGRAPH_H
+#define SCENEGRAPH_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define SCENE_NODE_NONE -1 // The parent index of a root node
+
+
+/* VARIABLES */
+// A single node in a scene graph. Position, Rotation and Scale are relative to the parent node, and are the only copy
+// of the node's SRT data. Everything else is derived from them by UpdateSceneGraph: LocalMatrix (cached, so a node
+// whose parent moved doesn't need any trig), WorldMatrix (kept in float so children can be built on top of it),
+// WorldMatrixFP (what the node is drawn with) and the world space bounds the node is culled with. Use the SetSceneNode* functions (or call MarkSceneNodeDirty after writing the local SRT data
+// directly) so the node and its children get rebuilt. SharedRenderBlock is set when RenderBlock belongs to the asset
+// manager
+struct SceneNode
+{
+    T3DMat4 LocalMatrix;
+    T3DMat4 WorldMatrix;
+    T3DMat4FP WorldMatrixFP;
+    T3DVec3 Position;
+    T3DVec3 Rotation;
+    T3DVec3 Scale;
+    T3DVec3 BoundsMin;
+    T3DVec3 BoundsMax;
+    rspq_block_t* RenderBlock;
+    T3DModel* Model;
+    int Parent;
+    bool SharedRenderBlock;
+    bool LocalDirty;
+    bool WorldDirty;
+};
+
+// A flat array of scene nodes. Parents are always stored before their children, so the whole
+// graph can be updated with one front-to-back pass over the array
+struct SceneGraph
+{
+    struct SceneNode* Nodes;
+    int NodeCount;
+    int Capacity;
+};
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+void CreateSceneGraph(struct SceneGraph* Graph, int Capacity);
+void FreeSceneGraph(struct SceneGraph* Graph);
+int AddSceneNode(struct SceneGraph* Graph, int Parent, T3DModel* Model);
+
+// ----- Node functions -----
+void SetSceneNodePosition(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Position);
+void SetSceneNodeRotation(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Rotation);
+void SetSceneNodeScale(struct SceneGraph* Graph, int NodeIndex, T3DVec3 Scale);
+void MarkSceneNodeDirty(struct SceneGraph* Graph, int NodeIndex);
+T3DVec3 GetSceneNodeWorldPosition(struct SceneGraph* Graph, int NodeIndex);
+
+// ----- Update functions -----
+void UpdateSceneGraph(struct SceneGraph* Graph);
+void RenderSceneGraph(struct SceneGraph* Graph);
+#endif
@@ -0,0 +1,340 @@
+/* N64 GAME ENGINE */
+// Spatial grid file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <math.h>
+#include <string.h>
+#include <libdragon.h>
+#include <t3d/t3d.h>
+#include <t3d/t3dmath.h>
+#include <t3d/t3dmodel.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "SpatialGrid.h"
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Convert a world space X / Z coordinate to a cell coordinate, clamped to the grid. Objects outside of the
+// grid end up in the edge cells, so they can still be found (just less efficiently)
+int WorldToCell(float WorldCoord, float Origin, float CellSize, int CellCount)
+{
+    int Cell = (int)floorf((WorldCoord - Origin) / CellSize);
+
+    return MAX(MIN(Cell, CellCount - 1), 0);
+}
+
+// Check if two bounding boxes overlap
+bool AABBsOverlap(T3DVec3* MinA, T3DVec3* MaxA, T3DVec3* MinB, T3DVec3* MaxB)
+{
+    return MinA->v[0] <= MaxB->v[0] && MaxA->v[0] >= MinB->v[0] &&
+           MinA->v[1] <= MaxB->v[1] && MaxA->v[1] >= MinB->v[1] &&
+           MinA->v[2] <= MaxB->v[2] && MaxA->v[2] >= MinB->v[2];
+}
+
+// Check if a sphere overlaps a bounding box, using the point in the box closest to the sphere's center
+bool SphereOverlapsAABB(T3DVec3* Center, float Radius, T3DVec3* Min, T3DVec3* Max)
+{
+    float DistanceSquared = 0.0f;
+
+    for (int Axis = 0; Axis < 3; Axis++)
+    {
+        float Closest = MAX(Min->v[Axis], MIN(Center->v[Axis], Max->v[Axis]));
+        float Delta = Center->v[Axis] - Closest;
+
+        DistanceSquared += Delta * Delta;
+    }
+
+    return DistanceSquared <= Radius * Radius;
+}
+
+// Add an entry to a query's results, unless it was already added by another cell during the same query
+int AddQueryResult(struct SpatialGrid* Grid, struct SpatialGridEntry* Entry, struct ModelObject** Results, int ResultCount, int MaxResults)
+{
+    if (Entry->QueryStamp == Grid->QueryStamp || ResultCount >= MaxResults)
+    {
+        return ResultCount;
+    }
+
+    Entry->QueryStamp = Grid->QueryStamp;
+    Results[ResultCount] = Entry->Object;
+    return ResultCount + 1;
+}
+
+// ----- Creation functions -----
+// Creates an empty spatial grid that covers WorldMin -> WorldMax on the X / Z plane, split into square cells
+void CreateSpatialGrid(struct SpatialGrid* Grid, T3DVec3 WorldMin, T3DVec3 WorldMax, float CellSize, int MaxObjects)
+{
+    Grid->Origin[0] = WorldMin.v[0];
+    Grid->Origin[1] = WorldMin.v[2];
+    Grid->CellSize = CellSize;
+    Grid->CellsX = MAX((int)ceilf((WorldMax.v[0] - WorldMin.v[0]) / CellSize), 1);
+    Grid->CellsZ = MAX((int)ceilf((WorldMax.v[2] - WorldMin.v[2]) / CellSize), 1);
+    Grid->MinY = WorldMin.v[1];
+    Grid->MaxY = WorldMax.v[1];
+    Grid->Entries = TaggedMalloc(sizeof(struct SpatialGridEntry) * MaxObjects, MEMORY_TAG_SCENE);
+    Grid->QueryResults = TaggedMalloc(sizeof(struct ModelObject*) * MaxObjects, MEMORY_TAG_SCENE);
+    Grid->CellStarts = TaggedMalloc(sizeof(int) * ((Grid->CellsX * Grid->CellsZ) + 1), MEMORY_TAG_SCENE);
+    Grid->CellEntries = NULL;
+    Grid->QueryStamp = 0;
+    Grid->EntryCount = 0;
+    Grid->EntryCapacity = MaxObjects;
+    Grid->IsBuilt = false;
+
+    DebugPrint("[INFO] >> Created spatial grid (%dx%d cells, %d objects max).\n", ALL, Grid->CellsX, Grid->CellsZ, MaxObjects);
+}
+
+// Frees a spatial grid (but not the objects in it)
+void FreeSpatialGrid(struct SpatialGrid* Grid)
+{
+    TaggedFree(Grid->Entries);
+    TaggedFree(Grid->QueryResults);
+    TaggedFree(Grid->CellStarts);
+    TaggedFree(Grid->CellEntries);
+
+    Grid->Entries = NULL;
+    Grid->QueryResults = NULL;
+    Grid->CellStarts = NULL;
+    Grid->CellEntries = NULL;
+    Grid->EntryCount = 0;
+    Grid->IsBuilt = false;
+}
+
+// Adds a static object to a spatial grid. The object's transform must already be in its final position, and the grid has
+// to be (re)built with BuildSpatialGrid before it can be queried
+void AddSpatialGridObject(struct SpatialGrid* Grid, struct ModelObject* Object)
+{
+    assertf(Grid->EntryCount < Grid->EntryCapacity, "The spatial grid is full (%d objects)!", Grid->EntryCapacity);
+
+    struct SpatialGridEntry* NewEntry = &Grid->Entries[Grid->EntryCount++];
+
+    UpdateTransformMatrix(&Object->Transform);
+    UpdateTransformBounds(&Object->Transform, Object->Model);
+
+    NewEntry->Object = Object;
+    NewEntry->BoundsMin = Object->Transform.BoundsMin;
+    NewEntry->BoundsMax = Object->Transform.BoundsMax;
+    NewEntry->QueryStamp = 0;
+
+    Grid->MinY = MIN(Grid->MinY, NewEntry->BoundsMin.v[1]);
+    Grid->MaxY = MAX(Grid->MaxY, NewEntry->BoundsMax.v[1]);
+    Grid->IsBuilt = false;
+}
+
+// Packs every object into the cells its bounding box overlaps. This is a counting sort, so the grid's cells end up in one
+// contiguous array with no per-cell allocations
+void BuildSpatialGrid(struct SpatialGrid* Grid)
+{
+    int CellCount = Grid->CellsX * Grid->CellsZ;
+    int TotalReferences = 0;
+
+    memset(Grid->CellStarts, 0, sizeof(int) * (CellCount + 1));
+
+    // Count how many entries land in each cell
+    for (int EntryIndex = 0; EntryIndex < Grid->EntryCount; EntryIndex++)
+    {
+        struct SpatialGridEntry* Entry = &Grid->Entries[EntryIndex];
+        int MinX = WorldToCell(Entry->BoundsMin.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+        int MaxX = WorldToCell(Entry->BoundsMax.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+        int MinZ = WorldToCell(Entry->BoundsMin.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+        int MaxZ = WorldToCell(Entry->BoundsMax.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+
+        for (int CellZ = MinZ; CellZ <= MaxZ; CellZ++)
+        {
+            for (int CellX = MinX; CellX <= MaxX; CellX++)
+            {
+                Grid->CellStarts[(CellZ * Grid->CellsX) + CellX + 1]++;
+                TotalReferences++;
+            }
+        }
+    }
+
+    // Turn the counts into start offsets
+    for (int CellIndex = 0; CellIndex < CellCount; CellIndex++)
+    {
+        Grid->CellStarts[CellIndex + 1] += Grid->CellStarts[CellIndex];
+    }
+
+    TaggedFree(Grid->CellEntries);
+    Grid->CellEntries = TaggedMalloc(sizeof(int) * MAX(TotalReferences, 1), MEMORY_TAG_SCENE);
+
+    // Fill the cells, using a temporary copy of the start offsets as write cursors
+    int* CellCursors = TaggedMalloc(sizeof(int) * CellCount, MEMORY_TAG_SCENE);
+    memcpy(CellCursors, Grid->CellStarts, sizeof(int) * CellCount);
+
+    for (int EntryIndex = 0; EntryIndex < Grid->EntryCount; EntryIndex++)
+    {
+        struct SpatialGridEntry* Entry = &Grid->Entries[EntryIndex];
+        int MinX = WorldToCell(Entry->BoundsMin.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+        int MaxX = WorldToCell(Entry->BoundsMax.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+        int MinZ = WorldToCell(Entry->BoundsMin.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+        int MaxZ = WorldToCell(Entry->BoundsMax.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+
+        for (int CellZ = MinZ; CellZ <= MaxZ; CellZ++)
+        {
+            for (int CellX = MinX; CellX <= MaxX; CellX++)
+            {
+                Grid->CellEntries[CellCursors[(CellZ * Grid->CellsX) + CellX]++] = EntryIndex;
+            }
+        }
+    }
+
+    TaggedFree(CellCursors);
+    Grid->IsBuilt = true;
+
+    DebugPrint("[INFO] >> Built spatial grid (%d objects, %d cell references).\n", ALL, Grid->EntryCount, TotalReferences);
+}
+
+// ----- Query functions -----
+// Find every object whose bounding box overlaps Min -> Max. Returns the number of objects written to Results
+int QuerySpatialGridAABB(struct SpatialGrid* Grid, T3DVec3 Min, T3DVec3 Max, struct ModelObject** Results, int MaxResults)
+{
+    assertf(Grid->IsBuilt == true, "The spatial grid must be built before it can be queried!");
+
+    int MinX = WorldToCell(Min.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MaxX = WorldToCell(Max.v[0], Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MinZ = WorldToCell(Min.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int MaxZ = WorldToCell(Max.v[2], Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int ResultCount = 0;
+
+    Grid->QueryStamp++;
+
+    for (int CellZ = MinZ; CellZ <= MaxZ; CellZ++)
+    {
+        for (int CellX = MinX; CellX <= MaxX; CellX++)
+        {
+            int CellIndex = (CellZ * Grid->CellsX) + CellX;
+
+            for (int Reference = Grid->CellStarts[CellIndex]; Reference < Grid->CellStarts[CellIndex + 1]; Reference++)
+            {
+                struct SpatialGridEntry* Entry = &Grid->Entries[Grid->CellEntries[Reference]];
+
+                if (AABBsOverlap(&Entry->BoundsMin, &Entry->BoundsMax, &Min, &Max) == true)
+                {
+                    ResultCount = AddQueryResult(Grid, Entry, Results, ResultCount, MaxResults);
+                }
+            }
+        }
+    }
+
+    return ResultCount;
+}
+
+// Find every object whose bounding box overlaps a sphere. Useful for gameplay proximity checks
+int QuerySpatialGridRadius(struct SpatialGrid* Grid, T3DVec3 Center, float Radius, struct ModelObject** Results, int MaxResults)
+{
+    assertf(Grid->IsBuilt == true, "The spatial grid must be built before it can be queried!");
+
+    int MinX = WorldToCell(Center.v[0] - Radius, Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MaxX = WorldToCell(Center.v[0] + Radius, Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MinZ = WorldToCell(Center.v[2] - Radius, Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int MaxZ = WorldToCell(Center.v[2] + Radius, Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int ResultCount = 0;
+
+    Grid->QueryStamp++;
+
+    for (int CellZ = MinZ; CellZ <= MaxZ; CellZ++)
+    {
+        for (int CellX = MinX; CellX <= MaxX; CellX++)
+        {
+            int CellIndex = (CellZ * Grid->CellsX) + CellX;
+
+            for (int Reference = Grid->CellStarts[CellIndex]; Reference < Grid->CellStarts[CellIndex + 1]; Reference++)
+            {
+                struct SpatialGridEntry* Entry = &Grid->Entries[Grid->CellEntries[Reference]];
+
+                if (SphereOverlapsAABB(&Center, Radius, &Entry->BoundsMin, &Entry->BoundsMax) == true)
+                {
+                    ResultCount = AddQueryResult(Grid, Entry, Results, ResultCount, MaxResults);
+                }
+            }
+        }
+    }
+
+    return ResultCount;
+}
+
+// Find every object whose bounding box is at least partially inside of a frustum. Only the cells within ViewDistance
+// of ViewPoint (usually the camera position and far clipping distance) are visited, and whole cells are rejected against
+// the frustum before their objects are tested
+int QuerySpatialGridFrustum(struct SpatialGrid* Grid, T3DFrustum* Frustum, T3DVec3 ViewPoint, float ViewDistance, struct ModelObject** Results, int MaxResults)
+{
+    assertf(Grid->IsBuilt == true, "The spatial grid must be built before it can be queried!");
+
+    int MinX = WorldToCell(ViewPoint.v[0] - ViewDistance, Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MaxX = WorldToCell(ViewPoint.v[0] + ViewDistance, Grid->Origin[0], Grid->CellSize, Grid->CellsX);
+    int MinZ = WorldToCell(ViewPoint.v[2] - ViewDistance, Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int MaxZ = WorldToCell(ViewPoint.v[2] + ViewDistance, Grid->Origin[1], Grid->CellSize, Grid->CellsZ);
+    int ResultCount = 0;
+
+    Grid->QueryStamp++;
+
+    for (int CellZ = MinZ; CellZ <= MaxZ; CellZ++)
+    {
+        for (int CellX = MinX; CellX <= MaxX; CellX++)
+        {
+            int CellIndex = (CellZ * Grid->CellsX) + CellX;
+
+            if (Grid->CellStarts[CellIndex] == Grid->CellStarts[CellIndex + 1])
+            {
+                continue;
+            }
+
+            // Edge cells also hold objects outside of the grid, so they can't be rejected as a whole
+            bool IsEdgeCell = CellX == 0 || CellZ == 0 || CellX == Grid->CellsX - 1 || CellZ == Grid->CellsZ - 1;
+            T3DVec3 CellMin = {{Grid->Origin[0] + (CellX * Grid->CellSize), Grid->MinY, Grid->Origin[1] + (CellZ * Grid->CellSize)}};
+            T3DVec3 CellMax = {{CellMin.v[0] + Grid->CellSize, Grid->MaxY, CellMin.v[2] + Grid->CellSize}};
+
+            if (IsEdgeCell == false && t3d_frustum_vs_aabb(Frustum, &CellMin, &CellMax) == false)
+            {
+                continue;
+            }
+
+            for (int Reference = Grid->CellStarts[CellIndex]; Reference < Grid->CellStarts[CellIndex + 1]; Reference++)
+            {
+                struct SpatialGridEntry* Entry = &Grid->Entries[Grid->CellEntries[Reference]];
+
+                if (Entry->QueryStamp != Grid->QueryStamp && t3d_frustum_vs_aabb(Frustum, &Entry->BoundsMin, &Entry->BoundsMax) == true)
+                {
+                    ResultCount = AddQueryResult(Grid, Entry, Results, ResultCount, MaxResults);
+                }
+            }
+        }
+    }
+
+    return ResultCount;
+}
+
+// ----- Drawing functions -----
+// Render every object in the grid that is inside of the current view frustum (see UpdateViewport). If frustum culling
+// is disabled, or the viewport hasn't been updated yet, every object is drawn like the other render functions do
+void RenderSpatialGridVisible(struct SpatialGrid* Grid)
+{
+    if (EnableFrustumCulling == false || ViewFrustumIsValid == false)
+    {
+        for (int EntryIndex = 0; EntryIndex < Grid->EntryCount; EntryIndex++)
+        {
+            RenderModelUnculled(Grid->Entries[EntryIndex].Object->Model, &Grid->Entries[EntryIndex].Object->Transform);
+        }
+
+        return;
+    }
+
+    int VisibleCount = QuerySpatialGridFrustum(Grid, &ViewFrustum, ViewPosition, CameraClipping[1], Grid->QueryResults, Grid->EntryCount);
+
+    // Objects that the grid rejected never reach the render functions, so they're counted as culled here. The results
+    // were already tested against the frustum by the query, so they're drawn without being tested again
+    CulledModelCount += Grid->EntryCount - VisibleCount;
+
+    for (int ResultIndex = 0; ResultIndex < VisibleCount; ResultIndex++)
+    {
+        RenderModelUnculled(Grid->QueryResults[ResultIndex]->Model, &Grid->QueryResults[ResultIndex]->Transform);
+    }
+}
@@ -0,0 +1,65 @@
+/* N64 GAME ENGINE */
+// Spatial grid header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define SPATIALGRID_H if it hasn't been already
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* VARIABLES */
+// A static object stored in a spatial grid, along with its world space bounding box
+struct SpatialGridEntry
+{
+    struct ModelObject* Object;
+    T3DVec3 BoundsMin;
+    T3DVec3 BoundsMax;
+    uint32_t QueryStamp;
+};
+
+// A uniform grid of cells on the X / Z plane that holds static model objects. Objects are added with
+// AddSpatialGridObject, and BuildSpatialGrid then packs every cell's entries into one contiguous array
+// (CellStarts[x] to CellStarts[x + 1] are the indices in CellEntries that belong to cell x)
+struct SpatialGrid
+{
+    struct SpatialGridEntry* Entries;
+    struct ModelObject** QueryResults;
+    int* CellStarts;
+    int* CellEntries;
+    float Origin[2];
+    float CellSize;
+    float MinY;
+    float MaxY;
+    uint32_t QueryStamp;
+    int EntryCount;
+    int EntryCapacity;
+    int CellsX;
+    int CellsZ;
+    bool IsBuilt;
+};
+
+
+/* FUNCTIONS */
+// ----- Creation functions -----
+void CreateSpatialGrid(struct SpatialGrid* Grid, T3DVec3 WorldMin, T3DVec3 WorldMax, float CellSize, int MaxObjects);
+void FreeSpatialGrid(struct SpatialGrid* Grid);
+void AddSpatialGridObject(struct SpatialGrid* Grid, struct ModelObject* Object);
+void BuildSpatialGrid(struct SpatialGrid* Grid);
+
+// ----- Query functions -----
+int QuerySpatialGridAABB(struct SpatialGrid* Grid, T3DVec3 Min, T3DVec3 Max, struct ModelObject** Results, int MaxResults);
+int QuerySpatialGridRadius(struct SpatialGrid* Grid, T3DVec3 Center, float Radius, struct ModelObject** Results, int MaxResults);
+int QuerySpatialGridFrustum(struct SpatialGrid* Grid, T3DFrustum* Frustum, T3DVec3 ViewPoint, float ViewDistance, struct ModelObject** Results, int MaxResults);
+
+// ----- Drawing functions -----
+void RenderSpatialGridVisible(struct SpatialGrid* Grid);
+#endif
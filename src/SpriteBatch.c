@@ -0,0 +1,255 @@
+/* N64 GAME ENGINE */
+// Sprite batch file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <stdlib.h>
+#include <string.h>
+#include <libdragon.h>
+#include "N64GameEngine.h"
+#include "AssetManager.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
+#include "SpriteBatch.h"
+
+
+/* VARIABLES */
+struct SpriteBatchItem QueuedSprites[SPRITE_BATCH_CAPACITY];
+int QueuedSpriteCount = 0;
+int SpriteBatchUploads = 0;
+int SpriteBatchDraws = 0;
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Work out which part of a sprite has to be loaded into TMEM to draw a region of it. Sprites that fit in TMEM are
+// loaded whole. Bigger (atlas) sprites are split into horizontal bands that each fill TMEM, and a region is drawn
+// from the band that contains it. Regions that cross a band edge are drawn with rdpq_sprite_blit instead
+void FindSpriteBand(struct SpriteBatchItem* Item)
+{
+    tex_format_t Format = sprite_get_format(Item->Sprite);
+    bool HasPalette = Format == FMT_CI4 || Format == FMT_CI8;
+    int TMEMBytes = HasPalette ? SPRITE_TMEM_PALETTE_BYTES : SPRITE_TMEM_BYTES;
+    int RowBytes = (TEX_FORMAT_PIX2BYTES(Format, Item->Sprite->width) + 7) & ~7; // TMEM rows are 8 byte aligned
+
+    Item->BandRows = Item->Sprite->height;
+
+    if (RowBytes * Item->Sprite->height <= TMEMBytes)
+    {
+        Item->Band = SPRITE_BAND_WHOLE;
+        return;
+    }
+
+    // Uploading part of a paletted sprite would need the palette to be set up separately, so those are always blitted
+    Item->BandRows = TMEMBytes / RowBytes;
+
+    if (HasPalette == true || Item->BandRows == 0)
+    {
+        Item->Band = SPRITE_BAND_BLIT;
+        return;
+    }
+
+    Item->Band = Item->T / Item->BandRows;
+
+    if (Item->T + Item->Height > (Item->Band + 1) * Item->BandRows)
+    {
+        Item->Band = SPRITE_BAND_BLIT;
+    }
+}
+
+// Sort order for queued sprites. Layers are drawn in order, and within a layer, sprites are grouped by texture and
+// TMEM band so each one is only uploaded once. Sprites in the same group keep the order they were queued in
+int CompareQueuedSprites(const void* A, const void* B)
+{
+    const struct SpriteBatchItem* Item1 = A;
+    const struct SpriteBatchItem* Item2 = B;
+
+    if (Item1->Layer != Item2->Layer)
+    {
+        return Item1->Layer < Item2->Layer ? -1 : 1;
+    }
+
+    if (Item1->Sprite != Item2->Sprite)
+    {
+        return (uintptr_t)Item1->Sprite < (uintptr_t)Item2->Sprite ? -1 : 1;
+    }
+
+    if (Item1->Band != Item2->Band)
+    {
+        return Item1->Band < Item2->Band ? -1 : 1;
+    }
+
+    return Item1->Order - Item2->Order;
+}
+
+// ----- Queue functions -----
+// Queue a whole sprite to be drawn at an X & Y position. Sprites in lower layers are drawn first
+void QueueSprite(sprite_t* Sprite, float XPos, float YPos, int Layer)
+{
+    QueueSpriteRegion(Sprite, 0, 0, Sprite->width, Sprite->height, XPos, YPos, 1.0f, Layer);
+}
+
+// Queue part of a sprite (like an icon in a texture atlas) to be drawn at an X & Y position, scaled by Scale. If the
+// batch is full, it's flushed first, so this should only be called in 2D mode
+void QueueSpriteRegion(sprite_t* Sprite, int S, int T, int Width, int Height, float XPos, float YPos, float Scale, int Layer)
+{
+    if (QueuedSpriteCount >= SPRITE_BATCH_CAPACITY)
+    {
+        DebugPrint("[INFO] >> The sprite batch is full, flushing it early.\n", ALL);
+        FlushSpriteBatch();
+    }
+
+    struct SpriteBatchItem* NewItem = &QueuedSprites[QueuedSpriteCount];
+
+    NewItem->Sprite = Sprite;
+    NewItem->XPos = XPos;
+    NewItem->YPos = YPos;
+    NewItem->Scale = Scale;
+    NewItem->S = S;
+    NewItem->T = T;
+    NewItem->Width = Width;
+    NewItem->Height = Height;
+    NewItem->Layer = Layer;
+    NewItem->Order = QueuedSpriteCount++;
+    FindSpriteBand(NewItem);
+}
+
+// Check if the sprite batch has any queued sprites
+bool IsSpriteBatchEmpty()
+{
+    return QueuedSpriteCount == 0;
+}
+
+// ----- Atlas functions -----
+// Load a texture atlas made by Utilities/AtlasPacker (see the EngineTest Makefile): the atlas sprite, and the table
+// of named regions in it. The table is kept in the format it was written in, so loading it is a single read. The sprite
+// is acquired through the asset manager, so atlases sharing a sprite only load it once
+void LoadSpriteAtlas(struct SpriteAtlas* Atlas, char* SpritePath, char* TablePath)
+{
+    int TableSize = 0;
+    uint8_t* TableData = asset_load(TablePath, &TableSize);
+
+    TrackAllocation(TableData, TableSize, MEMORY_TAG_SPRITE);
+    assertf(TableSize >= 8 && memcmp(TableData, "ATLS", 4) == 0, "\"%s\" isn't an atlas table!", TablePath);
+    assertf(*(uint16_t*)(TableData + 4) == ATLAS_TABLE_VERSION, "\"%s\" has an unsupported atlas table version (%d)!", TablePath, *(uint16_t*)(TableData + 4));
+
+    Atlas->TableData = TableData;
+    Atlas->RegionCount = *(uint16_t*)(TableData + 6);
+    Atlas->Regions = (struct AtlasRegion*)(TableData + 8);
+
+    Atlas->Sprite = AcquireSprite(SpritePath);
+
+    assertf(8 + (Atlas->RegionCount * (int)sizeof(struct AtlasRegion)) <= TableSize, "\"%s\" is truncated!", TablePath);
+    DebugPrint("[INFO] >> Loaded atlas \"%s\" with %d regions.\n", ALL, SpritePath, Atlas->RegionCount);
+}
+
+// Free a texture atlas' region table and release its sprite. Make sure the RDP is done drawing it first
+void FreeSpriteAtlas(struct SpriteAtlas* Atlas)
+{
+    rspq_wait();
+    UntrackAllocation(Atlas->TableData);
+    ReleaseAsset(Atlas->Sprite);
+    free(Atlas->TableData);
+
+    Atlas->Sprite = NULL;
+    Atlas->TableData = NULL;
+    Atlas->Regions = NULL;
+    Atlas->RegionCount = 0;
+}
+
+// Find a region in a texture atlas by name (the image's file name without its extension). Returns NULL if there's
+// no region with that name. Look regions up once and keep the pointer, instead of searching every frame
+struct AtlasRegion* FindAtlasRegion(struct SpriteAtlas* Atlas, char* Name)
+{
+    for (int RegionIndex = 0; RegionIndex < Atlas->RegionCount; RegionIndex++)
+    {
+        if (strncmp(Atlas->Regions[RegionIndex].Name, Name, ATLAS_NAME_LENGTH) == 0)
+        {
+            return &Atlas->Regions[RegionIndex];
+        }
+    }
+
+    return NULL;
+}
+
+// Queue a region of a texture atlas to be drawn at an X & Y position, scaled by Scale
+void QueueAtlasSprite(struct SpriteAtlas* Atlas, struct AtlasRegion* Region, float XPos, float YPos, float Scale, int Layer)
+{
+    QueueSpriteRegion(Atlas->Sprite, Region->S, Region->T, Region->Width, Region->Height, XPos, YPos, Scale, Layer);
+}
+
+// ----- Flush functions -----
+// Draw every queued sprite. Each texture (or TMEM band of an atlas) is uploaded once per group of sprites that use
+// it, and the render mode is only changed once for the whole batch
+void FlushSpriteBatch()
+{
+    if (QueuedSpriteCount == 0)
+    {
+        return;
+    }
+
+    sprite_t* LoadedSprite = NULL;
+    int LoadedBand = SPRITE_BAND_BLIT;
+
+    qsort(QueuedSprites, QueuedSpriteCount, sizeof(struct SpriteBatchItem), CompareQueuedSprites);
+
+    rdpq_mode_push();
+    rdpq_mode_alphacompare(1);
+
+    for (int ItemIndex = 0; ItemIndex < QueuedSpriteCount; ItemIndex++)
+    {
+        struct SpriteBatchItem* Item = &QueuedSprites[ItemIndex];
+
+        // rdpq_sprite_blit does its own uploads, so whatever was in TMEM has to be loaded again afterwards
+        if (Item->Band == SPRITE_BAND_BLIT)
+        {
+            rdpq_sprite_blit(Item->Sprite, Item->XPos, Item->YPos, &(rdpq_blitparms_t){
+                .s0 = Item->S,
+                .t0 = Item->T,
+                .width = Item->Width,
+                .height = Item->Height,
+                .scale_x = Item->Scale,
+                .scale_y = Item->Scale,
+            });
+
+            LoadedSprite = NULL;
+            SpriteBatchDraws++;
+            continue;
+        }
+
+        if (Item->Sprite != LoadedSprite || Item->Band != LoadedBand)
+        {
+            if (Item->Band == SPRITE_BAND_WHOLE)
+            {
+                rdpq_sprite_upload(TILE0, Item->Sprite, NULL);
+            }
+            else
+            {
+                surface_t Pixels = sprite_get_pixels(Item->Sprite);
+                int BandStart = Item->Band * Item->BandRows;
+
+                rdpq_tex_upload_sub(TILE0, &Pixels, NULL, 0, BandStart, Pixels.width, MIN(BandStart + Item->BandRows, Pixels.height));
+            }
+
+            LoadedSprite = Item->Sprite;
+            LoadedBand = Item->Band;
+            SpriteBatchUploads++;
+        }
+
+        // Texture coordinates are relative to the whole sprite, even if only a band of it is in TMEM
+        rdpq_texture_rectangle_scaled(TILE0,
+            Item->XPos, Item->YPos, Item->XPos + (Item->Width * Item->Scale), Item->YPos + (Item->Height * Item->Scale),
+            Item->S, Item->T, Item->S + Item->Width, Item->T + Item->Height
+        );
+
+        SpriteBatchDraws++;
+    }
+
+    rdpq_mode_pop();
+    QueuedSpriteCount = 0;
+}
@@ -0,0 +1,86 @@
+/* N64 GAME ENGINE */
+// Sprite batch header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+// Define SPRITEBATCH_H if it hasn't been already
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+
+
+/* DEFINITIONS */
+#define SPRITE_BATCH_CAPACITY 128 // The maximum number of queued sprites before the batch is flushed early
+#define SPRITE_TMEM_BYTES 4096 // The size of TMEM
+#define SPRITE_TMEM_PALETTE_BYTES 2048 // The part of TMEM left for pixels when a palette is loaded (CI4 / CI8)
+#define SPRITE_BAND_WHOLE -1 // The whole sprite fits in TMEM, so it's uploaded in one go
+#define SPRITE_BAND_BLIT -2 // The sprite region doesn't fit in a single TMEM load, so it's drawn with rdpq_sprite_blit
+#define ATLAS_NAME_LENGTH 32 // The length of a region name in an atlas table, including the terminator
+#define ATLAS_TABLE_VERSION 1 // The atlas table version written by Utilities/AtlasPacker
+
+
+/* VARIABLES */
+// A queued sprite draw. S, T, Width and Height select the part of the sprite (or atlas) to draw. Band is the
+// horizontal strip of the sprite that has to be in TMEM for this region (or one of the SPRITE_BAND_* values)
+struct SpriteBatchItem
+{
+    sprite_t* Sprite;
+    float XPos;
+    float YPos;
+    float Scale;
+    int S;
+    int T;
+    int Width;
+    int Height;
+    int Band;
+    int BandRows;
+    int Layer;
+    int Order;
+};
+
+// A named rectangle in a texture atlas. This matches the layout of an entry in the
+// .atlas tables written by Utilities/AtlasPacker, so the table is used in place
+struct AtlasRegion
+{
+    char Name[ATLAS_NAME_LENGTH];
+    uint16_t S;
+    uint16_t T;
+    uint16_t Width;
+    uint16_t Height;
+};
+
+// A texture atlas sprite and its region table (see LoadSpriteAtlas)
+struct SpriteAtlas
+{
+    sprite_t* Sprite;
+    void* TableData;
+    struct AtlasRegion* Regions;
+    int RegionCount;
+};
+
+extern int SpriteBatchUploads;
+extern int SpriteBatchDraws;
+
+
+/* FUNCTIONS */
+// ----- Queue functions -----
+void QueueSprite(sprite_t* Sprite, float XPos, float YPos, int Layer);
+void QueueSpriteRegion(sprite_t* Sprite, int S, int T, int Width, int Height, float XPos, float YPos, float Scale, int Layer);
+bool IsSpriteBatchEmpty();
+
+// ----- Atlas functions -----
+void LoadSpriteAtlas(struct SpriteAtlas* Atlas, char* SpritePath, char* TablePath);
+void FreeSpriteAtlas(struct SpriteAtlas* Atlas);
+struct AtlasRegion* FindAtlasRegion(struct SpriteAtlas* Atlas, char* Name);
+void QueueAtlasSprite(struct SpriteAtlas* Atlas, struct AtlasRegion* Region, float XPos, float YPos, float Scale, int Layer);
+
+// ----- Flush functions -----
+void FlushSpriteBatch();
+#endif
@@ -8,58 +8,479 @@
 
 
 /* LIBRARIES */
+#include <stdlib.h>
 #include <string.h>
 #include "N64GameEngine.h"
+#include "AssetManager.h"
+#include "MathUtils.h"
+#include "MemoryUtils.h"
 #include "TextUtils.h"
 
 
+/* VARIABLES */
+struct FontMetricsTable FontMetrics[MAX_MEASURED_FONTS];
+struct TextCacheEntry TextCache[TEXT_CACHE_MAX_ENTRIES];
+uint32_t TextCacheMissHistory[TEXT_CACHE_MISS_HISTORY];
+uint32_t TextCacheClock = 0;
+int TextCacheMissCursor = 0;
+int TextCacheEntryCount = 0;
+int TextCacheHits = 0;
+int TextCacheMisses = 0;
+int TextCacheBytesUsed = 0;
+int TextCacheBudget = TEXT_CACHE_DEFAULT_BUDGET;
+rdpq_paragraph_t* MeasureParagraph = NULL;
+int MeasureParagraphCapacity = 0;
+rdpq_textparms_t TextDrawParams = {
+    .valign = VALIGN_TOP,
+    .align = ALIGN_LEFT,
+    .width = 320,
+    .height = 240,
+    .wrap = WRAP_WORD,
+};
+
+
 /* FUNCTIONS */
 // ----- Registration functions -----
-// Registers a font to the specified font ID, with a custom color
+// Registers a font to the specified font ID, with a custom color. The font is acquired through the asset manager, so
+// registering a path that's already loaded reuses the loaded font. Its styles are shared too, so use a different style
+// ID (see DrawStringStyled) instead of registering the same font twice to draw it in another color
 rdpq_font_t* RegisterFontBasic(char* FontPath, color_t TextColor, color_t OutlineColor, int FontID)
 {
-    rdpq_font_t *NewFont = rdpq_font_load(FontPath);
+    rdpq_font_t *NewFont = AcquireFont(FontPath);
+
     rdpq_font_style(NewFont, 0, &(rdpq_fontstyle_t){
         .color = TextColor,
         .outline_color = OutlineColor,
     });
 
     rdpq_text_register_font(FontID, NewFont);
+    BuildFontMetricsTable(FontID, NewFont);
     return NewFont;
 }
 
 // Registers a font to the specified font ID, with the specified style
 rdpq_font_t* RegisterFontWithStyle(char* FontPath, int FontID, rdpq_fontstyle_t* FontStyle)
 {
-    rdpq_font_t *NewFont = rdpq_font_load(FontPath);
+    rdpq_font_t *NewFont = AcquireFont(FontPath);
+
     rdpq_font_style(NewFont, 0, FontStyle);
     rdpq_text_register_font(FontID, NewFont);
+    BuildFontMetricsTable(FontID, NewFont);
     return NewFont;
 }
 
+// ----- Layout cache functions -----
+// Hash a string (FNV-1a)
+uint32_t HashString(const char* String)
+{
+    uint32_t Hash = 2166136261u;
+
+    while (*String != '\0')
+    {
+        Hash = (Hash ^ (uint8_t)*String++) * 16777619u;
+    }
+
+    return Hash;
+}
+
+// Check if two sets of text parameters would produce the same layout. Only the fields that affect the layout are
+// compared, since the structs could have uninitialized padding
+bool TextParamsMatch(const rdpq_textparms_t* A, const rdpq_textparms_t* B)
+{
+    return A->width == B->width && A->height == B->height && A->align == B->align && A->valign == B->valign &&
+        A->indent == B->indent && A->max_chars == B->max_chars && A->char_spacing == B->char_spacing &&
+        A->line_spacing == B->line_spacing && A->wrap == B->wrap && A->tabstops == B->tabstops && A->style_id == B->style_id;
+}
+
+// Free a cached paragraph and remove it from the cache. The last entry is moved into its slot
+void EvictTextCacheEntry(int EntryIndex)
+{
+    struct TextCacheEntry* Entry = &TextCache[EntryIndex];
+
+    TextCacheBytesUsed -= Entry->Bytes;
+    UntrackAllocation(Entry->Paragraph);
+    rdpq_paragraph_free(Entry->Paragraph);
+    free(Entry->Text);
+
+    TextCache[EntryIndex] = TextCache[--TextCacheEntryCount];
+}
+
+// Evict the least recently used paragraphs until there's a free entry and BytesNeeded more bytes fit in the budget
+void MakeRoomInTextCache(int BytesNeeded)
+{
+    while (TextCacheEntryCount > 0 && (TextCacheEntryCount >= TEXT_CACHE_MAX_ENTRIES || TextCacheBytesUsed + BytesNeeded > TextCacheBudget))
+    {
+        int OldestIndex = 0;
+
+        for (int EntryIndex = 1; EntryIndex < TextCacheEntryCount; EntryIndex++)
+        {
+            if (TextCache[EntryIndex].LastUsed < TextCache[OldestIndex].LastUsed)
+            {
+                OldestIndex = EntryIndex;
+            }
+        }
+
+        EvictTextCacheEntry(OldestIndex);
+    }
+}
+
+// Check if a string was missed recently, and remember it if it wasn't
+bool WasTextMissedRecently(uint32_t Hash)
+{
+    for (int HistoryIndex = 0; HistoryIndex < TEXT_CACHE_MISS_HISTORY; HistoryIndex++)
+    {
+        if (TextCacheMissHistory[HistoryIndex] == Hash)
+        {
+            return true;
+        }
+    }
+
+    TextCacheMissHistory[TextCacheMissCursor] = Hash;
+    TextCacheMissCursor = (TextCacheMissCursor + 1) % TEXT_CACHE_MISS_HISTORY;
+    return false;
+}
+
+// Get the layout of a string, only building it if the same text, font, and parameters aren't already cached. The
+// returned paragraph is owned by the cache, so don't free it. It stays valid until the next GetCachedParagraph call
+// (which could evict it), so it should be rendered right away. A string is only cached the second time it misses, the
+// first time it's laid out in the frame arena. Strings that change every frame (like counters) would otherwise make
+// the cache allocate a new entry and free an old one every frame, which fragments the heap
+rdpq_paragraph_t* GetCachedParagraph(char* Text, int FontID, const rdpq_textparms_t* Params)
+{
+    uint32_t Hash = HashString(Text);
+
+    TextCacheClock++;
+
+    for (int EntryIndex = 0; EntryIndex < TextCacheEntryCount; EntryIndex++)
+    {
+        struct TextCacheEntry* Entry = &TextCache[EntryIndex];
+
+        if (Entry->Hash == Hash && Entry->FontID == FontID && TextParamsMatch(&Entry->Params, Params) && strcmp(Entry->Text, Text) == 0)
+        {
+            Entry->LastUsed = TextCacheClock;
+            TextCacheHits++;
+            return Entry->Paragraph;
+        }
+    }
+
+    TextCacheMisses++;
+
+    if (WasTextMissedRecently(Hash) == false)
+    {
+        rdpq_paragraph_t* FrameParagraph = BuildFrameParagraph(Text, FontID, Params);
+
+        if (FrameParagraph != NULL)
+        {
+            return FrameParagraph;
+        }
+    }
+
+    int StrLength = strlen(Text);
+    rdpq_paragraph_t* NewParagraph = rdpq_paragraph_build(Params, FontID, Text, &StrLength);
+    int Bytes = sizeof(rdpq_paragraph_t) + (NewParagraph->capacity * sizeof(rdpq_paragraph_char_t)) + strlen(Text) + 1;
+
+    MakeRoomInTextCache(Bytes);
+
+    // A paragraph that's bigger than the whole budget is still cached (alone), so it can be rendered
+    struct TextCacheEntry* NewEntry = &TextCache[TextCacheEntryCount++];
+
+    NewEntry->Paragraph = NewParagraph;
+    NewEntry->Params = *Params;
+    NewEntry->Text = strdup(Text);
+    NewEntry->Hash = Hash;
+    NewEntry->LastUsed = TextCacheClock;
+    NewEntry->FontID = FontID;
+    NewEntry->Bytes = Bytes;
+    TextCacheBytesUsed += Bytes;
+
+    // The entry's text is counted as part of its paragraph
+    TrackAllocation(NewParagraph, Bytes, MEMORY_TAG_TEXT);
+    assertf(NewEntry->Text != NULL, "Failed to allocate memory for a cached string!");
+    return NewParagraph;
+}
+
+// Lay out a string into a paragraph buffer the caller owns, which has room for Capacity characters. rdpq_paragraph_build
+// always allocates its own paragraph, so its font ($xx) and style (^xx) changes and newlines are handled the same way
+// here. Every byte of text makes at most one character, and the builder needs PARAGRAPH_EXTRA_CHARS on top of that,
+// so text longer than Capacity - PARAGRAPH_EXTRA_CHARS bytes is cut off (at a UTF-8 character boundary) instead of
+// letting the builder grow the buffer with realloc
+rdpq_paragraph_t* BuildParagraphInBuffer(rdpq_paragraph_t* Paragraph, int Capacity, char* Text, int FontID, const rdpq_textparms_t* Params)
+{
+    int TextBytes = strlen(Text);
+    int MaxBytes = MAX(Capacity - PARAGRAPH_EXTRA_CHARS, 0);
+
+    if (TextBytes > MaxBytes)
+    {
+        TextBytes = MaxBytes;
+
+        while (TextBytes > 0 && ((uint8_t)Text[TextBytes] & 0xC0) == 0x80)
+        {
+            TextBytes--;
+        }
+
+        DebugPrint("[WARNING] >> A paragraph buffer only has room for %d characters, the text was cut off.\n", ALL, MaxBytes);
+    }
+
+    const char* TextEnd = Text + TextBytes;
+
+    memset(Paragraph, 0, sizeof(rdpq_paragraph_t));
+    Paragraph->capacity = Capacity;
+    rdpq_paragraph_builder_begin(Params, FontID, Paragraph);
+
+    while (Text < TextEnd)
+    {
+        int SpanLength = MIN((int)strcspn(Text, "$^\n"), (int)(TextEnd - Text));
+
+        if (SpanLength > 0)
+        {
+            rdpq_paragraph_builder_span(Text, SpanLength);
+            Text += SpanLength;
+            continue;
+        }
+
+        if (*Text == '\n')
+        {
+            rdpq_paragraph_builder_newline();
+            Text++;
+        }
+        else if (Text + 1 < TextEnd && Text[1] == Text[0])
+        {
+            // "$$" and "^^" are escaped characters
+            rdpq_paragraph_builder_span(Text, 1);
+            Text += 2;
+        }
+        else if (Text + 2 < TextEnd)
+        {
+            char HexDigits[3] = {Text[1], Text[2], '\0'};
+            uint8_t Value = strtol(HexDigits, NULL, 16);
+
+            if (*Text == '$')
+            {
+                rdpq_paragraph_builder_font(Value);
+            }
+            else
+            {
+                rdpq_paragraph_builder_style(Value);
+            }
+
+            Text += 3;
+        }
+        else
+        {
+            rdpq_paragraph_builder_span(Text, 1);
+            Text++;
+        }
+    }
+
+    return rdpq_paragraph_builder_end();
+}
+
+// Lay out a string in the frame arena instead of on the heap. The paragraph is valid until the frame has been drawn,
+// and must not be freed. NULL is returned if the frame arena doesn't have enough space left
+rdpq_paragraph_t* BuildFrameParagraph(char* Text, int FontID, const rdpq_textparms_t* Params)
+{
+    // The paragraph is sized for the whole text, so nothing gets cut off
+    int Capacity = strlen(Text) + PARAGRAPH_EXTRA_CHARS;
+    rdpq_paragraph_t* Paragraph = TryFrameAlloc(sizeof(rdpq_paragraph_t) + (Capacity * sizeof(rdpq_paragraph_char_t)));
+
+    if (Paragraph == NULL)
+    {
+        return NULL;
+    }
+
+    return BuildParagraphInBuffer(Paragraph, Capacity, Text, FontID, Params);
+}
+
+// Set the number of bytes cached paragraphs can use, evicting paragraphs if the cache is now over budget
+void SetTextCacheBudget(int BudgetBytes)
+{
+    TextCacheBudget = BudgetBytes;
+    MakeRoomInTextCache(0);
+    DebugPrint("[INFO] >> Set text cache budget to %d bytes.\n", ALL, TextCacheBudget);
+}
+
+// Free every cached paragraph. This should be called if a registered font is replaced
+void ClearTextCache()
+{
+    while (TextCacheEntryCount > 0)
+    {
+        EvictTextCacheEntry(TextCacheEntryCount - 1);
+    }
+}
+
 // ----- Measurement functions -----
-// Returns the pixel height of a string
+// Precompute the advance widths and vertical extents of a font's ASCII characters, so strings can be measured
+// without building a paragraph. Any cached layouts are cleared too, since they could belong to a replaced font
+void BuildFontMetricsTable(int FontID, rdpq_font_t* Font)
+{
+    if (FontID <= 0 || FontID > MAX_MEASURED_FONTS)
+    {
+        DebugPrint("[INFO] >> Font ID %d is out of the metrics table range, its strings will be measured per glyph.\n", ALL, FontID);
+        return;
+    }
+
+    struct FontMetricsTable* Table = &FontMetrics[FontID - 1];
+    int MinTop = 0;
+    int MaxBottom = 0;
+
+    for (int Character = 0; Character < FONT_METRICS_ASCII_COUNT; Character++)
+    {
+        rdpq_font_gmetrics_t Metrics;
+
+        if (rdpq_font_get_glyph_metrics(Font, Character, &Metrics) == false)
+        {
+            Table->Advance[Character] = 0.0f;
+            Table->Top[Character] = 0;
+            Table->Bottom[Character] = 0;
+            continue;
+        }
+
+        Table->Advance[Character] = Metrics.xadvance;
+        Table->Top[Character] = Metrics.y0;
+        Table->Bottom[Character] = Metrics.y1;
+        MinTop = MIN(MinTop, Metrics.y0);
+        MaxBottom = MAX(MaxBottom, Metrics.y1);
+    }
+
+    Table->LineHeight = MaxBottom - MinTop;
+    Table->IsValid = true;
+    ClearTextCache();
+}
+
+// Get a font's precomputed metrics table, or NULL if the font doesn't have one
+struct FontMetricsTable* GetFontMetricsTable(int FontID)
+{
+    if (FontID <= 0 || FontID > MAX_MEASURED_FONTS || FontMetrics[FontID - 1].IsValid == false)
+    {
+        return NULL;
+    }
+
+    return &FontMetrics[FontID - 1];
+}
+
+// Decode the UTF-8 character at the start of a string, and return how many bytes it takes up
+int DecodeUTF8Char(const char* String, uint32_t* Codepoint)
+{
+    uint8_t FirstByte = (uint8_t)String[0];
+    int ByteCount = FirstByte >= 0xF0 ? 4 : FirstByte >= 0xE0 ? 3 : FirstByte >= 0xC0 ? 2 : 1;
+
+    *Codepoint = ByteCount == 1 ? FirstByte : FirstByte & (0x7F >> ByteCount);
+
+    for (int ByteIndex = 1; ByteIndex < ByteCount; ByteIndex++)
+    {
+        // Stop at a truncated sequence instead of reading past the end of the string
+        if (((uint8_t)String[ByteIndex] & 0xC0) != 0x80)
+        {
+            return ByteIndex;
+        }
+
+        *Codepoint = (*Codepoint << 6) | ((uint8_t)String[ByteIndex] & 0x3F);
+    }
+
+    return ByteCount;
+}
+
+// Get the metrics of a non-ASCII character (or any character of a font without a metrics table)
+bool GetUncachedGlyphMetrics(int FontID, uint32_t Codepoint, rdpq_font_gmetrics_t* Metrics)
+{
+    const rdpq_font_t* Font = rdpq_text_get_font(FontID);
+
+    return Font != NULL && rdpq_font_get_glyph_metrics(Font, Codepoint, Metrics);
+}
+
+// Returns the pixel height of a string (the distance between the highest glyph top and lowest glyph bottom). Each
+// extra line adds the font's full line height. Nothing is allocated
 int PixelStrHeight(char* String, int FontID)
 {
-    int CharNum = strlen(String);
-    rdpq_paragraph_t* NewParagraph = rdpq_paragraph_build(NULL, FontID, String, &CharNum);
-    int PixelHeight = NewParagraph->bbox.y1 - NewParagraph->bbox.y0;
+    struct FontMetricsTable* Table = GetFontMetricsTable(FontID);
+    int LineCount = 0;
+    int MinTop = 0;
+    int MaxBottom = 0;
+    int LineHeight = 0;
+
+    while (*String != '\0')
+    {
+        uint32_t Codepoint;
+        int Top = 0;
+        int Bottom = 0;
+
+        String += DecodeUTF8Char(String, &Codepoint);
+
+        if (Codepoint == '\n')
+        {
+            LineCount++;
+            continue;
+        }
+
+        if (Table != NULL && Codepoint < FONT_METRICS_ASCII_COUNT)
+        {
+            Top = Table->Top[Codepoint];
+            Bottom = Table->Bottom[Codepoint];
+        }
+        else
+        {
+            rdpq_font_gmetrics_t Metrics;
+
+            if (GetUncachedGlyphMetrics(FontID, Codepoint, &Metrics) == true)
+            {
+                Top = Metrics.y0;
+                Bottom = Metrics.y1;
+                LineHeight = MAX(LineHeight, Bottom - Top);
+            }
+        }
 
-    rdpq_paragraph_free(NewParagraph);
-    NewParagraph = NULL;
+        MinTop = MIN(MinTop, Top);
+        MaxBottom = MAX(MaxBottom, Bottom);
+    }
 
-    return PixelHeight;
+    if (Table != NULL)
+    {
+        LineHeight = Table->LineHeight;
+    }
+
+    return (MaxBottom - MinTop) + (LineCount * LineHeight);
 }
 
-// Returns the pixel width of a string
+// Returns the pixel width of a string, as it would be drawn by DrawString. The string is laid out with TextDrawParams,
+// so kerning, char_spacing, wrapping and font ($xx) changes are all included, and multi-line strings return the width
+// of their widest line. The layout's bounding box ends at the last glyph's edge, so trailing spaces (like the one at
+// the end of "FPS: ") are added on top. The layout goes into a reused buffer, which only grows when a longer string is
+// measured
 int PixelStrWidth(char* String, int FontID)
 {
-    int CharNum = strlen(String);
-    rdpq_paragraph_t* NewParagraph = rdpq_paragraph_build(NULL, FontID, String, &CharNum);
-    int PixelWidth = NewParagraph->bbox.x1 - NewParagraph->bbox.x0;
+    int Length = strlen(String);
+
+    if (Length + PARAGRAPH_EXTRA_CHARS > MeasureParagraphCapacity)
+    {
+        if (MeasureParagraph != NULL)
+        {
+            UntrackAllocation(MeasureParagraph);
+            free(MeasureParagraph);
+        }
+
+        MeasureParagraphCapacity = MAX(Length + PARAGRAPH_EXTRA_CHARS, 64);
+        MeasureParagraph = malloc(sizeof(rdpq_paragraph_t) + (MeasureParagraphCapacity * sizeof(rdpq_paragraph_char_t)));
+        assertf(MeasureParagraph != NULL, "Failed to allocate memory for measuring a string!");
+        TrackAllocation(MeasureParagraph, sizeof(rdpq_paragraph_t) + (MeasureParagraphCapacity * sizeof(rdpq_paragraph_char_t)), MEMORY_TAG_TEXT);
+    }
 
-    rdpq_paragraph_free(NewParagraph);
-    NewParagraph = NULL;
+    rdpq_paragraph_t* Paragraph = BuildParagraphInBuffer(MeasureParagraph, MeasureParagraphCapacity, String, FontID, &TextDrawParams);
+    struct FontMetricsTable* Table = GetFontMetricsTable(FontID);
+    float Width = Paragraph->nchars > 0 ? Paragraph->bbox.x1 : 0.0f;
 
-    return PixelWidth;
-}
\ No newline at end of file
+    for (int CharIndex = Length - 1; CharIndex >= 0 && String[CharIndex] == ' '; CharIndex--)
+    {
+        rdpq_font_gmetrics_t Metrics;
+
+        if (Table != NULL)
+        {
+            Width += Table->Advance[' '] + TextDrawParams.char_spacing;
+        }
+        else if (GetUncachedGlyphMetrics(FontID, ' ', &Metrics) == true)
+        {
+            Width += Metrics.xadvance + TextDrawParams.char_spacing;
+        }
+    }
+
+    return (int)(Width + 0.5f);
+}
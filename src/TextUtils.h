@@ -16,12 +16,62 @@
 #include "N64GameEngine.h"
 
 
+/* DEFINITIONS */
+#define TEXT_CACHE_MAX_ENTRIES 32 // The maximum number of cached paragraphs
+#define TEXT_CACHE_DEFAULT_BUDGET (16 * 1024) // The default number of bytes cached paragraphs (and their text) can use
+#define TEXT_CACHE_MISS_HISTORY 32 // The number of recently missed strings remembered (a string is only cached on its second miss)
+#define MAX_MEASURED_FONTS 16 // The number of font IDs (starting at 1) that get precomputed glyph metrics tables
+#define FONT_METRICS_ASCII_COUNT 128 // The number of ASCII characters in a glyph metrics table
+#define PARAGRAPH_EXTRA_CHARS 4 // The characters a paragraph buffer needs on top of its text's length (WRAP_ELLIPSES adds up to 3)
+
+
+/* VARIABLES */
+// A cached paragraph layout. Paragraphs are positioned when they're rendered, so
+// the same layout can be drawn anywhere on the screen
+struct TextCacheEntry
+{
+    rdpq_paragraph_t* Paragraph;
+    rdpq_textparms_t Params;
+    char* Text;
+    uint32_t Hash;
+    uint32_t LastUsed;
+    int FontID;
+    int Bytes;
+};
+
+// Precomputed metrics for the ASCII characters of a registered font. Glyph tops and bottoms
+// are relative to the baseline, so a line's height is MaxBottom - MinTop
+struct FontMetricsTable
+{
+    float Advance[FONT_METRICS_ASCII_COUNT];
+    int8_t Top[FONT_METRICS_ASCII_COUNT];
+    int8_t Bottom[FONT_METRICS_ASCII_COUNT];
+    int LineHeight;
+    bool IsValid;
+};
+
+extern int TextCacheHits;
+extern int TextCacheMisses;
+extern int TextCacheBytesUsed;
+extern int TextCacheBudget;
+extern rdpq_textparms_t TextDrawParams;
+
+
 /* FUNCTIONS */
 // ----- Registration functions -----
 rdpq_font_t* RegisterFontBasic(char* FontPath, color_t TextColor, color_t OutlineColor, int FontID);
 rdpq_font_t* RegisterFontWithStyle(char* FontPath, int FontID, rdpq_fontstyle_t* FontStyle);
 
+// ----- Layout cache functions -----
+rdpq_paragraph_t* GetCachedParagraph(char* Text, int FontID, const rdpq_textparms_t* Params);
+rdpq_paragraph_t* BuildParagraphInBuffer(rdpq_paragraph_t* Paragraph, int Capacity, char* Text, int FontID, const rdpq_textparms_t* Params);
+rdpq_paragraph_t* BuildFrameParagraph(char* Text, int FontID, const rdpq_textparms_t* Params);
+void SetTextCacheBudget(int BudgetBytes);
+void ClearTextCache();
+uint32_t HashString(const char* String);
+
 // ----- Measurement functions -----
-int PixelStrHeighjt(char* String, int FontID);
+void BuildFontMetricsTable(int FontID, rdpq_font_t* Font);
+int PixelStrHeight(char* String, int FontID);
 int PixelStrWidth(char* String, int FontID);
 #endif
\ No newline at end of file
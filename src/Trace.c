@@ -0,0 +1,222 @@
+/* N64 GAME ENGINE */
+// Binary trace log file
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+
+
+/* LIBRARIES */
+#include <string.h>
+#include <libdragon.h>
+#include "N64GameEngine.h"
+#include "MathUtils.h"
+#include "Trace.h"
+
+
+/* DEFINITIONS */
+#define TRACE_HEADER_BYTES 8 // ID (2 bytes), payload length (2 bytes), timestamp (4 bytes)
+#define TRACE_LINE_BYTES 32 // The number of record bytes written per "#TRACE" line
+#define TRACE_TEXT_BYTES 1024 // The size of the buffer "#TRACE" lines are collected in before they're written
+#define TRACE_MAX_FORMAT_BYTES 0x10000 // The largest the trace_fmt section can be, since IDs are 16 bit offsets into it
+
+
+/* VARIABLES */
+// The start and end of the section every trace format string is placed in. Their addresses are filled in by the linker.
+// They're weak so builds without any trace calls (and so without the section) still link
+extern const char __start_trace_fmt[] __attribute__((weak));
+extern const char __stop_trace_fmt[] __attribute__((weak));
+
+// Records are written to the active buffer while the other one is being flushed, so interrupt handlers can keep
+// tracing during a flush
+uint8_t TraceBuffers[2][TRACE_BUFFER_BYTES];
+uint8_t* TraceBuffer = TraceBuffers[0];
+char TraceText[TRACE_TEXT_BYTES];
+bool TraceAutoFlush = true;
+int TraceBufferUsed = 0;
+int TraceDroppedRecords = 0;
+int TraceUnreportedDrops = 0;
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Get the number of payload bytes an argument takes up in a trace record
+int GetTraceArgSize(const struct TraceArg* Arg)
+{
+    switch (Arg->Type)
+    {
+        case TRACE_ARG_STRING:
+            return 1 + (Arg->String != NULL ? strnlen(Arg->String, TRACE_STRING_MAX_BYTES) : 0);
+
+        case TRACE_ARG_VECTOR:
+        case TRACE_ARG_HSV:
+            return 12;
+
+        default:
+            return 4;
+    }
+}
+
+// Write a big endian 16 bit value to a byte buffer
+void TracePut16(uint8_t* Buffer, uint16_t Value)
+{
+    Buffer[0] = Value >> 8;
+    Buffer[1] = Value;
+}
+
+// Write a big endian 32 bit value to a byte buffer
+void TracePut32(uint8_t* Buffer, uint32_t Value)
+{
+    Buffer[0] = Value >> 24;
+    Buffer[1] = Value >> 16;
+    Buffer[2] = Value >> 8;
+    Buffer[3] = Value;
+}
+
+// Write a float's bits to a byte buffer (big endian)
+void TracePutFloat(uint8_t* Buffer, float Value)
+{
+    uint32_t Bits;
+
+    memcpy(&Bits, &Value, sizeof(Bits));
+    TracePut32(Buffer, Bits);
+}
+
+// ----- Trace functions -----
+// Check that every trace call site's ID fits in a record. This is called by InitSystem
+void InitTrace()
+{
+    uint32_t FormatBytes = __stop_trace_fmt - __start_trace_fmt;
+
+    assertf(FormatBytes <= TRACE_MAX_FORMAT_BYTES, "The trace format strings take up %d bytes, trace IDs only reach %d!", (int)FormatBytes, TRACE_MAX_FORMAT_BYTES);
+}
+
+// Write a trace record with the call site's ID, the current time, and the raw argument bytes. This is called by the
+// TRACE_* macros. If the buffer is full, the record is dropped and counted instead of flushing in the middle of a frame
+void WriteTraceRecord(const char* Format, const struct TraceArg* Args, int ArgCount)
+{
+    uint32_t Timestamp = TICKS_READ();
+    int PayloadBytes = 0;
+
+    for (int ArgIndex = 0; ArgIndex < ArgCount; ArgIndex++)
+    {
+        PayloadBytes += GetTraceArgSize(&Args[ArgIndex]);
+    }
+
+    // Space is reserved with interrupts disabled, so interrupt handlers can trace too
+    disable_interrupts();
+
+    if (TraceBufferUsed + TRACE_HEADER_BYTES + PayloadBytes > TRACE_BUFFER_BYTES)
+    {
+        TraceDroppedRecords++;
+        TraceUnreportedDrops++;
+        enable_interrupts();
+        return;
+    }
+
+    uint8_t* Record = &TraceBuffer[TraceBufferUsed];
+    TraceBufferUsed += TRACE_HEADER_BYTES + PayloadBytes;
+    enable_interrupts();
+
+    TracePut16(Record, (uint16_t)(Format - __start_trace_fmt));
+    TracePut16(Record + 2, PayloadBytes);
+    TracePut32(Record + 4, Timestamp);
+    Record += TRACE_HEADER_BYTES;
+
+    for (int ArgIndex = 0; ArgIndex < ArgCount; ArgIndex++)
+    {
+        const struct TraceArg* Arg = &Args[ArgIndex];
+
+        switch (Arg->Type)
+        {
+            case TRACE_ARG_FLOAT:
+                TracePutFloat(Record, Arg->Float);
+                break;
+
+            case TRACE_ARG_STRING:
+                Record[0] = GetTraceArgSize(Arg) - 1;
+                memcpy(Record + 1, Arg->String, Record[0]);
+                break;
+
+            case TRACE_ARG_VECTOR:
+                TracePutFloat(Record, Arg->Vector.v[0]);
+                TracePutFloat(Record + 4, Arg->Vector.v[1]);
+                TracePutFloat(Record + 8, Arg->Vector.v[2]);
+                break;
+
+            case TRACE_ARG_HSV:
+                TracePutFloat(Record, Arg->HSV.H);
+                TracePutFloat(Record + 4, Arg->HSV.S);
+                TracePutFloat(Record + 8, Arg->HSV.V);
+                break;
+
+            case TRACE_ARG_COLOR:
+                Record[0] = Arg->Color.r;
+                Record[1] = Arg->Color.g;
+                Record[2] = Arg->Color.b;
+                Record[3] = Arg->Color.a;
+                break;
+
+            default:
+                TracePut32(Record, Arg->Int);
+                break;
+        }
+
+        Record += GetTraceArgSize(Arg);
+    }
+}
+
+// Write every buffered trace record to the console as "#TRACE" hex lines. Records can be split across lines, the
+// decoder joins the lines back into one stream. This is called once per frame by EndFrame if TraceAutoFlush is set.
+// The buffers are swapped with interrupts disabled, so a record traced by an interrupt handler during the flush goes
+// into the next one instead of being lost
+void FlushTrace()
+{
+    const char* HexDigits = "0123456789ABCDEF";
+    int TextUsed = 0;
+
+    disable_interrupts();
+
+    uint8_t* FlushBuffer = TraceBuffer;
+    int FlushBytes = TraceBufferUsed;
+    int FlushDrops = TraceUnreportedDrops;
+
+    TraceBuffer = TraceBuffer == TraceBuffers[0] ? TraceBuffers[1] : TraceBuffers[0];
+    TraceBufferUsed = 0;
+    TraceUnreportedDrops = 0;
+    enable_interrupts();
+
+    for (int LineStart = 0; LineStart < FlushBytes; LineStart += TRACE_LINE_BYTES)
+    {
+        int LineBytes = MIN(TRACE_LINE_BYTES, FlushBytes - LineStart);
+
+        // "#TRACE " + 2 hex digits per byte + "\n"
+        if (TextUsed + 8 + (LineBytes * 2) > TRACE_TEXT_BYTES)
+        {
+            debugf("%.*s", TextUsed, TraceText);
+            TextUsed = 0;
+        }
+
+        memcpy(&TraceText[TextUsed], "#TRACE ", 7);
+        TextUsed += 7;
+
+        for (int ByteIndex = LineStart; ByteIndex < LineStart + LineBytes; ByteIndex++)
+        {
+            TraceText[TextUsed++] = HexDigits[FlushBuffer[ByteIndex] >> 4];
+            TraceText[TextUsed++] = HexDigits[FlushBuffer[ByteIndex] & 0xF];
+        }
+
+        TraceText[TextUsed++] = '\n';
+    }
+
+    if (TextUsed > 0)
+    {
+        debugf("%.*s", TextUsed, TraceText);
+    }
+
+    if (FlushDrops > 0)
+    {
+        debugf("#TRACE-DROPPED %d\n", FlushDrops);
+    }
+}
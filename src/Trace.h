@@ -0,0 +1,138 @@
+/* N64 GAME ENGINE */
+// Binary trace log header
+// Written by agent
+// October of 2026
+// Thanks to the LibDragon and Tiny3D libraries for making this project possible
+// LibDragon github -> https://github.com/DragonMinded/libdragon
+// Tiny3D github -> https://github.com/HailToDodongo/tiny3d
+//
+// Trace calls work like DebugPrint, but nothing is formatted on the N64. Every call site's format string is placed
+// in the "trace_fmt" section, and its offset in that section is the call site's ID (IDs are 16 bit, which InitSystem
+// checks the section fits in). A trace record only holds the ID, a timestamp, and the raw argument bytes. The records
+// are written to the console as "#TRACE" hex lines, and Utilities/TraceDecoder turns them back into text with the
+// trace_fmt section extracted from the ELF at build time (see the EngineTest Makefile).
+//
+// ENGINE_TRACE_LEVEL picks which calls are compiled in. Calls above the level compile to nothing, so their arguments
+// aren't evaluated either:
+//  TRACE_LEVEL_NONE -> No trace calls
+//  TRACE_LEVEL_MINIMAL -> TRACE_MINIMAL calls
+//  TRACE_LEVEL_ALL -> TRACE_MINIMAL and TRACE_ALL calls
+//
+// Supported argument types are integers (%d, %i, %u, %x, %X, %o, %c), floats (%f, %e, %g), strings (%s, up to 255
+// bytes are copied), vectors (%v, T3DVec3), colors (%C, color_t), and HSV colors (%H, struct HSVColor). Up to
+// TRACE_MAX_ARGS arguments can be passed. Pointers should be cast to an integer (%x), and arguments with a top level
+// comma in them (like compound literals) have to be wrapped in parentheses. Like DebugPrint, end the format with \n
+
+
+// Define TRACE_H if it hasn't been already
+#ifndef TRACE_H
+#define TRACE_H
+
+
+/* LIBRARIES */
+#include "N64GameEngine.h"
+#include "ColorUtils.h"
+
+
+/* DEFINITIONS */
+#define TRACE_LEVEL_NONE 0
+#define TRACE_LEVEL_MINIMAL 1
+#define TRACE_LEVEL_ALL 2
+
+#ifndef ENGINE_TRACE_LEVEL
+#define ENGINE_TRACE_LEVEL TRACE_LEVEL_MINIMAL
+#endif
+
+#define TRACE_BUFFER_BYTES 4096 // The number of bytes of trace records buffered between flushes
+#define TRACE_MAX_ARGS 8 // The maximum number of arguments a trace call can have
+#define TRACE_STRING_MAX_BYTES 255 // Longer string arguments are cut off
+
+// Argument type tags. The decoder works out the types from the format string, these are only used on the N64
+#define TRACE_ARG_INT 'i'
+#define TRACE_ARG_FLOAT 'f'
+#define TRACE_ARG_STRING 's'
+#define TRACE_ARG_VECTOR 'v'
+#define TRACE_ARG_COLOR 'C'
+#define TRACE_ARG_HSV 'H'
+
+// Turn each argument into a struct TraceArg, picking the type at compile time
+#define TRACE_ARG(Arg) _Generic((Arg), \
+    float: TraceArgFloat, \
+    double: TraceArgFloat, \
+    char*: TraceArgString, \
+    const char*: TraceArgString, \
+    T3DVec3: TraceArgVector, \
+    color_t: TraceArgColor, \
+    struct HSVColor: TraceArgHSV, \
+    default: TraceArgInt)(Arg)
+
+#define TRACE_ARGS_0()
+#define TRACE_ARGS_1(A) TRACE_ARG(A)
+#define TRACE_ARGS_2(A, ...) TRACE_ARG(A), TRACE_ARGS_1(__VA_ARGS__)
+#define TRACE_ARGS_3(A, ...) TRACE_ARG(A), TRACE_ARGS_2(__VA_ARGS__)
+#define TRACE_ARGS_4(A, ...) TRACE_ARG(A), TRACE_ARGS_3(__VA_ARGS__)
+#define TRACE_ARGS_5(A, ...) TRACE_ARG(A), TRACE_ARGS_4(__VA_ARGS__)
+#define TRACE_ARGS_6(A, ...) TRACE_ARG(A), TRACE_ARGS_5(__VA_ARGS__)
+#define TRACE_ARGS_7(A, ...) TRACE_ARG(A), TRACE_ARGS_6(__VA_ARGS__)
+#define TRACE_ARGS_8(A, ...) TRACE_ARG(A), TRACE_ARGS_7(__VA_ARGS__)
+#define TRACE_COUNT_ARGS(...) TRACE_COUNT_ARGS_(__VA_OPT__(__VA_ARGS__,) 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TRACE_COUNT_ARGS_(_1, _2, _3, _4, _5, _6, _7, _8, Count, ...) Count
+#define TRACE_CONCAT(A, B) TRACE_CONCAT_(A, B)
+#define TRACE_CONCAT_(A, B) A##B
+#define TRACE_ARGS(...) TRACE_CONCAT(TRACE_ARGS_, TRACE_COUNT_ARGS(__VA_ARGS__))(__VA_ARGS__)
+
+// Write a trace record. The format string has to be a string literal
+#define TRACE_EMIT(Format, ...) do { \
+    static const char TraceFormat[] __attribute__((section("trace_fmt"), used, aligned(1))) = Format; \
+    const struct TraceArg TraceArgs[] = { TRACE_ARGS(__VA_ARGS__) }; \
+    WriteTraceRecord(TraceFormat, TraceArgs, sizeof(TraceArgs) / sizeof(struct TraceArg)); \
+} while (0)
+
+#if ENGINE_TRACE_LEVEL >= TRACE_LEVEL_MINIMAL
+#define TRACE_MINIMAL(Format, ...) TRACE_EMIT(Format __VA_OPT__(,) __VA_ARGS__)
+#else
+#define TRACE_MINIMAL(Format, ...) do { } while (0)
+#endif
+
+#if ENGINE_TRACE_LEVEL >= TRACE_LEVEL_ALL
+#define TRACE_ALL(Format, ...) TRACE_EMIT(Format __VA_OPT__(,) __VA_ARGS__)
+#else
+#define TRACE_ALL(Format, ...) do { } while (0)
+#endif
+
+
+/* VARIABLES */
+// A single trace call argument
+struct TraceArg
+{
+    char Type;
+    union
+    {
+        int32_t Int;
+        float Float;
+        const char* String;
+        T3DVec3 Vector;
+        color_t Color;
+        struct HSVColor HSV;
+    };
+};
+
+extern bool TraceAutoFlush;
+extern int TraceDroppedRecords;
+
+
+/* FUNCTIONS */
+// ----- Argument functions -----
+// These are only used by TRACE_ARG, and are inline so the arguments are built right at the call site
+static inline struct TraceArg TraceArgInt(int32_t Value) { return (struct TraceArg){.Type = TRACE_ARG_INT, .Int = Value}; }
+static inline struct TraceArg TraceArgFloat(double Value) { return (struct TraceArg){.Type = TRACE_ARG_FLOAT, .Float = Value}; }
+static inline struct TraceArg TraceArgString(const char* Value) { return (struct TraceArg){.Type = TRACE_ARG_STRING, .String = Value}; }
+static inline struct TraceArg TraceArgVector(T3DVec3 Value) { return (struct TraceArg){.Type = TRACE_ARG_VECTOR, .Vector = Value}; }
+static inline struct TraceArg TraceArgColor(color_t Value) { return (struct TraceArg){.Type = TRACE_ARG_COLOR, .Color = Value}; }
+static inline struct TraceArg TraceArgHSV(struct HSVColor Value) { return (struct TraceArg){.Type = TRACE_ARG_HSV, .HSV = Value}; }
+
+// ----- Trace functions -----
+void InitTrace();
+void WriteTraceRecord(const char* Format, const struct TraceArg* Args, int ArgCount);
+void FlushTrace();
+#endif
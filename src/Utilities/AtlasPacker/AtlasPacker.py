@@ -0,0 +1,301 @@
+#!/usr/bin/env python3
+# N64 GAME ENGINE
+# Texture atlas packer (runs on the host, as part of the asset pipeline)
+# Written by agent
+# October of 2026
+#
+# Packs a group of PNG images into one atlas PNG (which is then converted with mksprite), and writes a sidecar table
+# with the rectangle of every image, so the engine can look images up by name (see LoadSpriteAtlas in SpriteBatch.c).
+# Images are packed into shelves that never cross a TMEM band edge. A band is the number of atlas rows that fill TMEM
+# in the chosen texture format, which is exactly what the engine's sprite batch uploads at once. Every image in the
+# same band can then be drawn with a single TMEM load.
+#
+# Only the Python standard library is used, so this doesn't need any extra packages.
+#
+# Usage: AtlasPacker.py --output-png Atlas.png --output-table Atlas.atlas [--format RGBA16] [--padding 0] Images...
+#
+# Table format (big endian, so the N64 can read it in place):
+#   char[4] Magic ("ATLS"), uint16 Version (1), uint16 RegionCount
+#   RegionCount x { char[32] Name (file name without extension, NUL padded), uint16 S, T, Width, Height }
+
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+
+# The size of TMEM, and the part that's left for pixels when a palette is loaded
+TMEM_BYTES = 4096
+TMEM_PALETTE_BYTES = 2048
+
+# Bits per pixel of the texture formats mksprite can output
+FORMAT_BITS = {
+    "RGBA32": 32,
+    "RGBA16": 16,
+    "IA16": 16,
+    "IA8": 8,
+    "I8": 8,
+    "CI8": 8,
+    "IA4": 4,
+    "I4": 4,
+    "CI4": 4,
+}
+
+TABLE_MAGIC = b"ATLS"
+TABLE_VERSION = 1
+TABLE_NAME_LENGTH = 32
+MAX_ATLAS_WIDTH = 1024
+PNG_SIGNATURE = b"\x89PNG\r\n\x1a\n"
+
+
+# ----- PNG functions -----
+# Undo the PNG row filters of one image, and return the raw rows
+def UnfilterRows(Data, Width, Height, BytesPerPixel):
+    RowBytes = Width * BytesPerPixel
+    Rows = []
+    Previous = bytearray(RowBytes)
+    Offset = 0
+
+    for _ in range(Height):
+        FilterType = Data[Offset]
+        Row = bytearray(Data[Offset + 1:Offset + 1 + RowBytes])
+        Offset += RowBytes + 1
+
+        for Index in range(RowBytes):
+            Left = Row[Index - BytesPerPixel] if Index >= BytesPerPixel else 0
+            Up = Previous[Index]
+            UpLeft = Previous[Index - BytesPerPixel] if Index >= BytesPerPixel else 0
+
+            if FilterType == 1:
+                Row[Index] = (Row[Index] + Left) & 0xFF
+            elif FilterType == 2:
+                Row[Index] = (Row[Index] + Up) & 0xFF
+            elif FilterType == 3:
+                Row[Index] = (Row[Index] + ((Left + Up) >> 1)) & 0xFF
+            elif FilterType == 4:
+                Estimate = Left + Up - UpLeft
+                DistanceLeft = abs(Estimate - Left)
+                DistanceUp = abs(Estimate - Up)
+                DistanceUpLeft = abs(Estimate - UpLeft)
+
+                if DistanceLeft <= DistanceUp and DistanceLeft <= DistanceUpLeft:
+                    Predictor = Left
+                elif DistanceUp <= DistanceUpLeft:
+                    Predictor = Up
+                else:
+                    Predictor = UpLeft
+
+                Row[Index] = (Row[Index] + Predictor) & 0xFF
+            elif FilterType != 0:
+                raise ValueError("Unknown PNG filter type %d" % FilterType)
+
+        Rows.append(Row)
+        Previous = Row
+
+    return Rows
+
+
+# Load a PNG file and return its width, height, and RGBA pixels (one bytearray per row)
+# Only 8 bit, non-interlaced images are supported, which is what mksprite's usual inputs look like
+def LoadPNG(Path):
+    with open(Path, "rb") as File:
+        Data = File.read()
+
+    if Data[:8] != PNG_SIGNATURE:
+        raise ValueError("%s is not a PNG file" % Path)
+
+    Offset = 8
+    ImageData = b""
+    Palette = b""
+    Transparency = b""
+    Width = Height = BitDepth = ColorType = Interlace = 0
+
+    while Offset < len(Data):
+        Length, ChunkType = struct.unpack(">I4s", Data[Offset:Offset + 8])
+        Chunk = Data[Offset + 8:Offset + 8 + Length]
+        Offset += Length + 12
+
+        if ChunkType == b"IHDR":
+            Width, Height, BitDepth, ColorType, _, _, Interlace = struct.unpack(">IIBBBBB", Chunk)
+        elif ChunkType == b"PLTE":
+            Palette = Chunk
+        elif ChunkType == b"tRNS":
+            Transparency = Chunk
+        elif ChunkType == b"IDAT":
+            ImageData += Chunk
+        elif ChunkType == b"IEND":
+            break
+
+    if BitDepth != 8 or Interlace != 0:
+        raise ValueError("%s: only 8 bit, non-interlaced PNGs are supported" % Path)
+
+    Channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(ColorType)
+
+    if Channels is None:
+        raise ValueError("%s: unsupported PNG color type %d" % (Path, ColorType))
+
+    Rows = UnfilterRows(zlib.decompress(ImageData), Width, Height, Channels)
+    Pixels = []
+
+    for Row in Rows:
+        RGBARow = bytearray(Width * 4)
+
+        for X in range(Width):
+            Source = Row[X * Channels:(X + 1) * Channels]
+
+            if ColorType == 0:
+                RGBA = (Source[0], Source[0], Source[0], 255)
+            elif ColorType == 2:
+                RGBA = (Source[0], Source[1], Source[2], 255)
+            elif ColorType == 3:
+                Alpha = Transparency[Source[0]] if Source[0] < len(Transparency) else 255
+                RGBA = (Palette[Source[0] * 3], Palette[Source[0] * 3 + 1], Palette[Source[0] * 3 + 2], Alpha)
+            elif ColorType == 4:
+                RGBA = (Source[0], Source[0], Source[0], Source[1])
+            else:
+                RGBA = tuple(Source)
+
+            RGBARow[X * 4:(X + 1) * 4] = bytes(RGBA)
+
+        Pixels.append(RGBARow)
+
+    return Width, Height, Pixels
+
+
+# Write RGBA pixels (one bytearray per row) to a PNG file
+def SavePNG(Path, Width, Height, Pixels):
+    def Chunk(ChunkType, ChunkData):
+        return struct.pack(">I", len(ChunkData)) + ChunkType + ChunkData + struct.pack(">I", zlib.crc32(ChunkType + ChunkData) & 0xFFFFFFFF)
+
+    RawData = b"".join(b"\x00" + bytes(Row) for Row in Pixels)
+
+    with open(Path, "wb") as File:
+        File.write(PNG_SIGNATURE)
+        File.write(Chunk(b"IHDR", struct.pack(">IIBBBBB", Width, Height, 8, 6, 0, 0, 0)))
+        File.write(Chunk(b"IDAT", zlib.compress(RawData, 9)))
+        File.write(Chunk(b"IEND", b""))
+
+
+# ----- Packing functions -----
+# Get how many rows of an atlas fit in TMEM at once. TMEM rows are 8 byte aligned
+def GetBandRows(AtlasWidth, Format):
+    RowBytes = (AtlasWidth * FORMAT_BITS[Format] // 8 + 7) & ~7
+    Budget = TMEM_PALETTE_BYTES if Format.startswith("CI") else TMEM_BYTES
+
+    return max(Budget // RowBytes, 0)
+
+
+# Pack images into shelves for an atlas of a specific width, and return (height, placements), or None if an image
+# doesn't fit. Images have to be sorted tallest first. A shelf that would cross a band edge starts at the next band
+def PackShelves(Images, AtlasWidth, BandRows, Padding):
+    Placements = {}
+    ShelfX = ShelfY = ShelfHeight = 0
+
+    for Name, Width, Height, _ in Images:
+        PaddedWidth = Width + Padding
+        PaddedHeight = Height + Padding
+
+        if PaddedWidth > AtlasWidth:
+            return None
+
+        if ShelfHeight == 0 or ShelfX + PaddedWidth > AtlasWidth:
+            ShelfY += ShelfHeight
+            ShelfX = 0
+            ShelfHeight = PaddedHeight
+
+            if BandRows > 0 and Height <= BandRows and ShelfY // BandRows != (ShelfY + Height - 1) // BandRows:
+                ShelfY = (ShelfY // BandRows + 1) * BandRows
+
+        Placements[Name] = (ShelfX, ShelfY)
+        ShelfX += PaddedWidth
+
+    return ShelfY + ShelfHeight, Placements
+
+
+# Try every power of two atlas width, and keep the packing with the smallest area (and the fewest bands if two
+# packings have the same area)
+def PackAtlas(Images, Format, Padding):
+    Best = None
+    AtlasWidth = 8
+
+    while AtlasWidth <= MAX_ATLAS_WIDTH:
+        BandRows = GetBandRows(AtlasWidth, Format)
+        Result = PackShelves(Images, AtlasWidth, BandRows, Padding)
+
+        if Result is not None:
+            Height, Placements = Result
+            Bands = (Height + BandRows - 1) // BandRows if BandRows > 0 else Height
+            Score = (AtlasWidth * Height, Bands)
+
+            if Best is None or Score < Best[0]:
+                Best = (Score, AtlasWidth, Height, BandRows, Placements)
+
+        AtlasWidth *= 2
+
+    if Best is None:
+        raise ValueError("The images don't fit in a %d pixel wide atlas" % MAX_ATLAS_WIDTH)
+
+    return Best[1:]
+
+
+# ----- Output functions -----
+# Write the sidecar table with every image's rectangle in the atlas
+def SaveTable(Path, Images, Placements):
+    with open(Path, "wb") as File:
+        File.write(TABLE_MAGIC + struct.pack(">HH", TABLE_VERSION, len(Images)))
+
+        for Name, Width, Height, _ in sorted(Images):
+            EncodedName = Name.encode("utf-8")
+
+            if len(EncodedName) >= TABLE_NAME_LENGTH:
+                raise ValueError("The image name \"%s\" is too long for the atlas table" % Name)
+
+            S, T = Placements[Name]
+            File.write(EncodedName.ljust(TABLE_NAME_LENGTH, b"\x00") + struct.pack(">HHHH", S, T, Width, Height))
+
+
+def main():
+    Parser = argparse.ArgumentParser(description="Pack PNG images into a TMEM band aware texture atlas")
+    Parser.add_argument("--output-png", required=True, help="Path of the atlas PNG to write")
+    Parser.add_argument("--output-table", required=True, help="Path of the region table to write")
+    Parser.add_argument("--format", default="RGBA16", choices=sorted(FORMAT_BITS), help="The texture format the atlas will be converted to")
+    Parser.add_argument("--padding", type=int, default=0, help="Empty pixels between images (use 1 or more with bilinear filtering)")
+    Parser.add_argument("images", nargs="+", help="PNG images to pack")
+    Arguments = Parser.parse_args()
+
+    Images = []
+
+    for Path in Arguments.images:
+        Name = os.path.splitext(os.path.basename(Path))[0]
+        Width, Height, Pixels = LoadPNG(Path)
+        Images.append((Name, Width, Height, Pixels))
+
+    if len(set(Image[0] for Image in Images)) != len(Images):
+        raise ValueError("Two images have the same name")
+
+    Images.sort(key=lambda Image: (-Image[2], -Image[1], Image[0]))
+    AtlasWidth, AtlasHeight, BandRows, Placements = PackAtlas(Images, Arguments.format, Arguments.padding)
+    AtlasPixels = [bytearray(AtlasWidth * 4) for _ in range(AtlasHeight)]
+
+    for Name, Width, Height, Pixels in Images:
+        S, T = Placements[Name]
+
+        if Height > BandRows:
+            print("[WARN] >> %s is taller than a TMEM band (%d rows), it will be drawn with a blit" % (Name, BandRows), file=sys.stderr)
+
+        for Row in range(Height):
+            AtlasPixels[T + Row][S * 4:(S + Width) * 4] = Pixels[Row]
+
+    SavePNG(Arguments.output_png, AtlasWidth, AtlasHeight, AtlasPixels)
+    SaveTable(Arguments.output_table, Images, Placements)
+    print("[INFO] >> Packed %d images into a %dx%d atlas (%d rows per TMEM band)" % (len(Images), AtlasWidth, AtlasHeight, BandRows))
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as Error:
+        print("[ERROR] >> %s" % Error, file=sys.stderr)
+        sys.exit(1)
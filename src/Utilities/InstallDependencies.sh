@@ -1,6 +1,7 @@
 #!/bin/bash
 ### OVERVIEW ###
-# This script downloads a prebuilt MIPS toolchain and installs it. It also installs libdragon, tiny3d, and ares.
+# This script downloads a prebuilt MIPS toolchain and installs it. It also installs libdragon, tiny3d, and ares, and
+# Blender (the EngineTest build uses it to generate the LOD levels of its models, see Utilities/LODGenerator).
 # It must be called like so: source InstallDependencies.sh
 
 
@@ -16,7 +17,7 @@ export N64_INST=$InstallPath
 
 echo Installing build dependencies...
 sudo apt-get update
-sudo apt-get install -y build-essential texinfo git pkg-config libgtk-3-dev libcanberra-gtk-module libgl-dev libasound2-dev
+sudo apt-get install -y build-essential texinfo git pkg-config libgtk-3-dev libcanberra-gtk-module libgl-dev libasound2-dev python3 blender
 
 echo ""
 echo Downloading and installing prebuild toolchain...
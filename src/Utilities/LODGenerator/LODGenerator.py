@@ -0,0 +1,72 @@
+# N64 GAME ENGINE
+# LOD model generator (runs on the host inside of Blender, as part of the asset pipeline)
+# Written by agent
+# October of 2026
+#
+# Makes a lower detail copy of a glTF model for a LOD chain (see CreateNewLODModelObject in N64GameEngine.c). Every
+# mesh in the model gets a collapse decimate modifier with the given ratio, which is applied before the model is
+# exported again. Materials, UVs and custom properties (like Fast64's material settings, which the Tiny3D converter
+# reads) are kept, so the output converts with the same settings as the base model.
+#
+# Usage: blender --background --factory-startup --python LODGenerator.py -- --input Model.glb --output Model_LOD1.glb --ratio 0.5
+
+
+import argparse
+import sys
+
+import bpy
+
+
+# Blender passes its own arguments to the script too, the script's start after "--"
+def GetScriptArguments():
+    if "--" in sys.argv:
+        return sys.argv[sys.argv.index("--") + 1:]
+
+    return []
+
+
+def main():
+    Parser = argparse.ArgumentParser(description="Generate a decimated LOD level of a glTF model")
+    Parser.add_argument("--input", required=True, help="Path of the base model (.glb)")
+    Parser.add_argument("--output", required=True, help="Path of the LOD model to write (.glb)")
+    Parser.add_argument("--ratio", type=float, required=True, help="The fraction of the base model's triangles to keep (0 - 1)")
+    Arguments = Parser.parse_args(GetScriptArguments())
+
+    if Arguments.ratio <= 0.0 or Arguments.ratio > 1.0:
+        raise ValueError("The ratio has to be between 0 and 1 (got %f)" % Arguments.ratio)
+
+    # Start from an empty scene, so only the imported model is exported
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    bpy.ops.import_scene.gltf(filepath=Arguments.input)
+
+    TrianglesBefore = 0
+    TrianglesAfter = 0
+
+    for Object in bpy.context.scene.objects:
+        if Object.type != "MESH":
+            continue
+
+        TrianglesBefore += sum(len(Polygon.vertices) - 2 for Polygon in Object.data.polygons)
+
+        Modifier = Object.modifiers.new(name="LOD", type="DECIMATE")
+        Modifier.decimate_type = "COLLAPSE"
+        Modifier.ratio = Arguments.ratio
+        Modifier.use_collapse_triangulate = True
+
+        bpy.context.view_layer.objects.active = Object
+        bpy.ops.object.modifier_apply(modifier=Modifier.name)
+        TrianglesAfter += sum(len(Polygon.vertices) - 2 for Polygon in Object.data.polygons)
+
+    if TrianglesBefore == 0:
+        raise ValueError("%s doesn't have any meshes" % Arguments.input)
+
+    bpy.ops.export_scene.gltf(filepath=Arguments.output, export_format="GLB", export_extras=True, export_apply=True)
+    print("[INFO] >> %s: %d -> %d triangles (ratio %.2f)" % (Arguments.output, TrianglesBefore, TrianglesAfter, Arguments.ratio))
+
+
+if __name__ == "__main__":
+    try:
+        main()
+    except ValueError as Error:
+        print("[ERROR] >> %s" % Error, file=sys.stderr)
+        sys.exit(1)
@@ -0,0 +1,291 @@
+/* N64 GAME ENGINE */
+// Binary trace log decoder (runs on the host)
+// Written by agent
+// October of 2026
+//
+// Reads a console log, decodes the "#TRACE" hex lines written by FlushTrace (see Trace.c) back into text, and passes
+// every other line through unchanged. The format strings come from the trace_fmt section of the ROM's ELF, which the
+// EngineTest Makefile extracts into a .tracefmt file at build time. A record's ID is its format string's offset in
+// that file. Use the .tracefmt file from the same build as the ROM, since the IDs change whenever the code does.
+//
+// Usage: TraceDecoder Game.tracefmt [LogFile] (the log is read from stdin if no file is given)
+
+
+/* LIBRARIES */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+
+/* DEFINITIONS */
+#define TRACE_HEADER_BYTES 8
+#define TICKS_PER_MILLISECOND 46875.0 // The N64's timer counts at half of the CPU's 93.75 MHz clock
+#define MAX_LINE_LENGTH 4096
+#define MAX_SPEC_LENGTH 32
+
+
+/* VARIABLES */
+char* FormatTable = NULL;
+long FormatTableSize = 0;
+uint8_t* Stream = NULL;
+long StreamSize = 0;
+long StreamCapacity = 0;
+int DecodedRecords = 0;
+
+
+/* FUNCTIONS */
+// ----- Helper functions -----
+// Read a whole file into memory
+char* ReadFile(const char* Path, long* Size)
+{
+    FILE* File = fopen(Path, "rb");
+
+    if (File == NULL)
+    {
+        return NULL;
+    }
+
+    fseek(File, 0, SEEK_END);
+    *Size = ftell(File);
+    fseek(File, 0, SEEK_SET);
+
+    char* Data = malloc(*Size + 1);
+
+    if (Data != NULL && fread(Data, 1, *Size, File) != (size_t)*Size)
+    {
+        free(Data);
+        Data = NULL;
+    }
+
+    if (Data != NULL)
+    {
+        Data[*Size] = '\0';
+    }
+
+    fclose(File);
+    return Data;
+}
+
+// Read a big endian 16 bit value
+uint16_t Get16(const uint8_t* Buffer)
+{
+    return (Buffer[0] << 8) | Buffer[1];
+}
+
+// Read a big endian 32 bit value
+uint32_t Get32(const uint8_t* Buffer)
+{
+    return ((uint32_t)Buffer[0] << 24) | ((uint32_t)Buffer[1] << 16) | ((uint32_t)Buffer[2] << 8) | Buffer[3];
+}
+
+// Read a big endian float
+float GetFloat(const uint8_t* Buffer)
+{
+    uint32_t Bits = Get32(Buffer);
+    float Value;
+
+    memcpy(&Value, &Bits, sizeof(Value));
+    return Value;
+}
+
+// Convert a hex digit to its value, or -1 if it isn't one
+int HexValue(char Digit)
+{
+    if (Digit >= '0' && Digit <= '9') return Digit - '0';
+    if (Digit >= 'A' && Digit <= 'F') return Digit - 'A' + 10;
+    if (Digit >= 'a' && Digit <= 'f') return Digit - 'a' + 10;
+    return -1;
+}
+
+// ----- Decoding functions -----
+// Print one record's format string with its arguments. Returns false if the payload doesn't match the format string
+int PrintRecord(const char* Format, const uint8_t* Payload, int PayloadBytes)
+{
+    const uint8_t* PayloadEnd = Payload + PayloadBytes;
+
+    while (*Format != '\0')
+    {
+        if (*Format != '%')
+        {
+            putchar(*Format++);
+            continue;
+        }
+
+        // Copy the whole specifier (flags, width, precision), but drop length modifiers since every integer is 32 bit
+        char Spec[MAX_SPEC_LENGTH];
+        int SpecLength = 0;
+
+        Spec[SpecLength++] = *Format++;
+
+        while (*Format != '\0' && strchr("-+ #0123456789.hlLqjzt", *Format) != NULL && SpecLength < MAX_SPEC_LENGTH - 2)
+        {
+            if (strchr("hlLqjzt", *Format) == NULL)
+            {
+                Spec[SpecLength++] = *Format;
+            }
+
+            Format++;
+        }
+
+        char Conversion = *Format++;
+        Spec[SpecLength++] = Conversion;
+        Spec[SpecLength] = '\0';
+
+        if (Conversion == '%')
+        {
+            putchar('%');
+        }
+        else if (strchr("diuxXoc", Conversion) != NULL)
+        {
+            if (Payload + 4 > PayloadEnd) return 0;
+            printf(Spec, (int32_t)Get32(Payload));
+            Payload += 4;
+        }
+        else if (strchr("fFeEgG", Conversion) != NULL)
+        {
+            if (Payload + 4 > PayloadEnd) return 0;
+            printf(Spec, (double)GetFloat(Payload));
+            Payload += 4;
+        }
+        else if (Conversion == 's')
+        {
+            if (Payload + 1 > PayloadEnd || Payload + 1 + Payload[0] > PayloadEnd) return 0;
+            printf("%.*s", Payload[0], (const char*)Payload + 1);
+            Payload += 1 + Payload[0];
+        }
+        else if (Conversion == 'v')
+        {
+            if (Payload + 12 > PayloadEnd) return 0;
+            printf("{X=%f, Y=%f, Z=%f}", GetFloat(Payload), GetFloat(Payload + 4), GetFloat(Payload + 8));
+            Payload += 12;
+        }
+        else if (Conversion == 'H')
+        {
+            if (Payload + 12 > PayloadEnd) return 0;
+            printf("{H=%f, S=%f, V=%f}", GetFloat(Payload), GetFloat(Payload + 4), GetFloat(Payload + 8));
+            Payload += 12;
+        }
+        else if (Conversion == 'C')
+        {
+            if (Payload + 4 > PayloadEnd) return 0;
+            printf("{R=%d, G=%d, B=%d, A=%d}", Payload[0], Payload[1], Payload[2], Payload[3]);
+            Payload += 4;
+        }
+        else
+        {
+            printf("<unsupported %%%c>", Conversion);
+        }
+    }
+
+    return Payload == PayloadEnd;
+}
+
+// Decode every complete record in the stream, and keep any partial record for the next line
+void DecodeStream()
+{
+    long Offset = 0;
+
+    while (StreamSize - Offset >= TRACE_HEADER_BYTES)
+    {
+        uint16_t ID = Get16(&Stream[Offset]);
+        uint16_t PayloadBytes = Get16(&Stream[Offset + 2]);
+        uint32_t Timestamp = Get32(&Stream[Offset + 4]);
+
+        if (StreamSize - Offset < TRACE_HEADER_BYTES + PayloadBytes)
+        {
+            break;
+        }
+
+        printf("[%10.3f ms] ", Timestamp / TICKS_PER_MILLISECOND);
+
+        if (ID >= FormatTableSize)
+        {
+            printf("<unknown trace ID %u, is the .tracefmt file from this build?>\n", ID);
+        }
+        else if (PrintRecord(&FormatTable[ID], &Stream[Offset + TRACE_HEADER_BYTES], PayloadBytes) == 0)
+        {
+            printf(" <argument size mismatch>\n");
+        }
+
+        DecodedRecords++;
+        Offset += TRACE_HEADER_BYTES + PayloadBytes;
+    }
+
+    memmove(Stream, &Stream[Offset], StreamSize - Offset);
+    StreamSize -= Offset;
+}
+
+// Add the bytes of a "#TRACE" hex line to the stream
+void AppendHexLine(const char* Hex)
+{
+    while (HexValue(Hex[0]) >= 0 && HexValue(Hex[1]) >= 0)
+    {
+        if (StreamSize >= StreamCapacity)
+        {
+            StreamCapacity = StreamCapacity > 0 ? StreamCapacity * 2 : 4096;
+            Stream = realloc(Stream, StreamCapacity);
+
+            if (Stream == NULL)
+            {
+                fprintf(stderr, "[ERROR] >> Out of memory\n");
+                exit(1);
+            }
+        }
+
+        Stream[StreamSize++] = (HexValue(Hex[0]) << 4) | HexValue(Hex[1]);
+        Hex += 2;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        fprintf(stderr, "Usage: %s Game.tracefmt [LogFile]\n", argv[0]);
+        return 1;
+    }
+
+    FormatTable = ReadFile(argv[1], &FormatTableSize);
+
+    if (FormatTable == NULL)
+    {
+        fprintf(stderr, "[ERROR] >> Failed to read the trace format table \"%s\"\n", argv[1]);
+        return 1;
+    }
+
+    FILE* Log = argc == 3 ? fopen(argv[2], "r") : stdin;
+
+    if (Log == NULL)
+    {
+        fprintf(stderr, "[ERROR] >> Failed to open the log \"%s\"\n", argv[2]);
+        return 1;
+    }
+
+    char Line[MAX_LINE_LENGTH];
+
+    while (fgets(Line, sizeof(Line), Log) != NULL)
+    {
+        if (strncmp(Line, "#TRACE ", 7) == 0)
+        {
+            AppendHexLine(Line + 7);
+            DecodeStream();
+        }
+        else if (strncmp(Line, "#TRACE-DROPPED ", 15) == 0)
+        {
+            printf("[WARNING] >> %d trace records were dropped (the trace buffer was full)\n", atoi(Line + 15));
+        }
+        else
+        {
+            fputs(Line, stdout);
+        }
+    }
+
+    if (StreamSize > 0)
+    {
+        fprintf(stderr, "[WARNING] >> The log ended in the middle of a trace record (%ld bytes left)\n", StreamSize);
+    }
+
+    fprintf(stderr, "[INFO] >> Decoded %d trace records\n", DecodedRecords);
+    return 0;
+}